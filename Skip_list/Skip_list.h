@@ -1,15 +1,39 @@
 ﻿#pragma once
+#include <new>
+#include <cmath>
+#include <array>
+#include <ratio>
+#include <set>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <thread>
+#include <limits>
 #include <memory>
+#include <memory_resource>
 #include <utility>
 #include <vector>
-#include <memory>
 #include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <optional>
 #include <concepts>
 #include <type_traits>
 #include <initializer_list>
 #include "random_number.h"
+#include "epoch_reclamation.h"
+#include "skip_list_serialization.h"
+#if !defined(__GNUC__) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#endif
 #include "skip_list_exception.h"
 
+#if defined(_MSC_VER)
+#define SKIP_LIST_NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+#define SKIP_LIST_NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
 namespace skip_list_space
 {
 	template<size_t Max_level>
@@ -124,6 +148,13 @@ namespace skip_list_space
 		{const_predicate.operator()(value_first, value_second)} -> std::same_as<bool>;
 	};
 
+	// generator(max_lvl) returns a node level; results outside [1, max_lvl] are clamped into it.
+	template <class Generator>
+	concept level_generator_policy = std::is_default_constructible_v<Generator> && requires(Generator generator, const size_t max_lvl)
+	{
+		{generator(max_lvl)} -> std::convertible_to<size_t>;
+	};
+
 	template <class Value>
 	concept valid_Value = std::is_copy_constructible_v<Value>;
 
@@ -146,174 +177,541 @@ namespace skip_list_space
 		{const_other == const_key} -> std::same_as<bool>;
 	};
 
+	inline constexpr size_t default_max_level = 32;
+
+	struct sorted_unique_t
+	{
+		explicit sorted_unique_t() = default;
+	};
+
+	inline constexpr sorted_unique_t sorted_unique{};
+
+	inline void prefetch_node(const void* address) noexcept
+	{
+#if defined(__GNUC__)
+		__builtin_prefetch(address);
+#elif defined(_M_IX86) || defined(_M_X64)
+		_mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#else
+		static_cast<void>(address);
+#endif
+	}
+
+	template <size_t Max_level>
+	struct skip_list_statistics
+	{
+		size_t inserts = 0;
+		size_t finds = 0;
+		size_t erases = 0;
+		size_t searches = 0;
+		size_t nodes_visited = 0;
+		size_t comparisons = 0;
+		size_t list_level = 0;
+		size_t head_level = 0;
+		size_t bytes_allocated = 0;
+		std::array<size_t, Max_level> level_histogram{};
+
+		[[nodiscard]] double nodes_visited_per_search() const noexcept
+		{
+			return searches == 0 ? 0.0 : static_cast<double>(nodes_visited) / static_cast<double>(searches);
+		}
+
+		[[nodiscard]] double comparisons_per_search() const noexcept
+		{
+			return searches == 0 ? 0.0 : static_cast<double>(comparisons) / static_cast<double>(searches);
+		}
+	};
+
+	struct no_search_probe
+	{
+		void visited() const noexcept {}
+		void compared() const noexcept {}
+	};
+
+	class operation_counters final
+	{
+		mutable std::atomic<size_t> inserts{ 0 };
+		mutable std::atomic<size_t> finds{ 0 };
+		mutable std::atomic<size_t> erases{ 0 };
+		mutable std::atomic<size_t> searches{ 0 };
+		mutable std::atomic<size_t> nodes_visited{ 0 };
+		mutable std::atomic<size_t> comparisons{ 0 };
+
+	public:
+		class search_probe final
+		{
+			const operation_counters& counters;
+			size_t visited_count = 0;
+			size_t comparison_count = 0;
+
+		public:
+			search_probe(const operation_counters& counters_, const size_t search_count) noexcept : counters(counters_)
+			{
+				counters.searches.fetch_add(search_count, std::memory_order_relaxed);
+			}
+
+			search_probe(const search_probe&) = delete;
+			search_probe& operator=(const search_probe&) = delete;
+
+			~search_probe()
+			{
+				counters.nodes_visited.fetch_add(visited_count, std::memory_order_relaxed);
+				counters.comparisons.fetch_add(comparison_count, std::memory_order_relaxed);
+			}
+
+			void visited() noexcept { ++visited_count; }
+			void compared() noexcept { ++comparison_count; }
+		};
+
+		operation_counters() = default;
+		operation_counters(const operation_counters&) noexcept {}
+		operation_counters& operator=(const operation_counters&) noexcept { return *this; }
+
+		[[nodiscard]] search_probe start_search(const size_t search_count = 1) const noexcept { return search_probe(*this, search_count); }
+		void count_insert(const size_t count = 1) const noexcept { inserts.fetch_add(count, std::memory_order_relaxed); }
+		void count_find(const size_t count = 1) const noexcept { finds.fetch_add(count, std::memory_order_relaxed); }
+		void count_erase(const size_t count = 1) const noexcept { erases.fetch_add(count, std::memory_order_relaxed); }
+
+		template <size_t Max_level>
+		void fill(skip_list_statistics<Max_level>& statistics) const noexcept
+		{
+			statistics.inserts = inserts.load(std::memory_order_relaxed);
+			statistics.finds = finds.load(std::memory_order_relaxed);
+			statistics.erases = erases.load(std::memory_order_relaxed);
+			statistics.searches = searches.load(std::memory_order_relaxed);
+			statistics.nodes_visited = nodes_visited.load(std::memory_order_relaxed);
+			statistics.comparisons = comparisons.load(std::memory_order_relaxed);
+		}
+
+		void reset() noexcept
+		{
+			for (auto counter : { &inserts, &finds, &erases, &searches, &nodes_visited, &comparisons })
+			{
+				counter->store(0, std::memory_order_relaxed);
+			}
+		}
+	};
+
+	struct no_operation_counters
+	{
+		[[nodiscard]] no_search_probe start_search(const size_t = 1) const noexcept { return {}; }
+		void count_insert(const size_t = 1) const noexcept {}
+		void count_find(const size_t = 1) const noexcept {}
+		void count_erase(const size_t = 1) const noexcept {}
+	};
+
+	template <typename Node, typename Key, typename Compare, typename Probe = no_search_probe>
+	[[nodiscard]] Node* next_less_key_element(Node* node, const int lvl_index, const Key& key, const Node* tail, const Compare& compare,
+		Probe&& probe = {})
+	{
+		for (auto right_node = node->get_right_node(lvl_index); right_node != tail; right_node = node->get_right_node(lvl_index))
+		{
+			probe.compared();
+			if (!compare(right_node->get_key(), key))
+			{
+				break;
+			}
+			probe.visited();
+			node = right_node;
+		}
+		return node;
+	}
+
+	template <class Generator>
+	struct promotion_probability
+	{
+		using type = std::ratio<1, 2>;
+	};
+
+	template <class Generator>
+		requires requires { typename Generator::probability; }
+	struct promotion_probability<Generator>
+	{
+		using type = typename Generator::probability;
+	};
+
 	template <typename Key,
-		typename Value, size_t Max_level, typename Alloc = std::allocator<std::pair<const Key, Value>>>
+		typename Value, size_t Max_level, typename Alloc = std::allocator<std::pair<const Key, Value>>, bool Indexable = false,
+		bool Shared_readers = false>
 	class node final
 	{
-		std::vector<node*> right_nodes{};
-		std::vector<node*> left_nodes{};
-		std::pair<const Key, Value>* node_value = nullptr;
+		using value_type = std::pair<const Key, Value>;
+
+		node* left_node = nullptr;
 		Level<Max_level> level{};
-		Alloc allocator{};
 		bool valid = false;
+		alignas(value_type) unsigned char node_value[sizeof(value_type)]{};
 
-		void init_node_value(std::pair<const Key, Value>* value, Level<Max_level> level_)
+		explicit node(const Level<Max_level> level_) noexcept : level(level_) {}
+
+		[[nodiscard]] node** right_nodes() noexcept
+		{
+			return reinterpret_cast<node**>(reinterpret_cast<unsigned char*>(this) + sizeof(node));
+		}
+
+		[[nodiscard]] node* const* right_nodes() const noexcept
+		{
+			return reinterpret_cast<node* const*>(reinterpret_cast<const unsigned char*>(this) + sizeof(node));
+		}
+
+		[[nodiscard]] size_t* widths() noexcept requires Indexable
+		{
+			return reinterpret_cast<size_t*>(right_nodes() + level.get_size());
+		}
+
+		[[nodiscard]] const size_t* widths() const noexcept requires Indexable
+		{
+			return reinterpret_cast<const size_t*>(right_nodes() + level.get_size());
+		}
+
+		[[nodiscard]] value_type* value_pointer() noexcept { return std::launder(reinterpret_cast<value_type*>(node_value)); }
+		[[nodiscard]] const value_type* value_pointer() const noexcept { return std::launder(reinterpret_cast<const value_type*>(node_value)); }
+
+		[[nodiscard]] static node* load_link(node* const& link) noexcept
+		{
+			if constexpr (Shared_readers)
+			{
+				return std::atomic_ref<node*>(const_cast<node*&>(link)).load(std::memory_order_acquire);
+			}
+			else
+			{
+				return link;
+			}
+		}
+
+		static void publish_link(node*& link, node* value_) noexcept
 		{
-			set_null_neighbours(level_);
-			if (node_value != nullptr)
+			if constexpr (Shared_readers)
+			{
+				std::atomic_ref<node*>(link).store(value_, std::memory_order_release);
+			}
+			else
 			{
-				allocator.deallocate(node_value, sizeof(*value));
+				link = value_;
 			}
-			node_value = allocator.allocate(sizeof(*value));
-			node_value->first = value->first;
-			node_value->second = value->second;
 		}
 
-		void init_node_value(std::vector<node*>&& right_nodes_, std::vector<node*>&& left_nodes_, std::pair<const Key, Value>* value) noexcept
+		template<typename Pool>
+		static node* allocate_node(Pool& pool, const Level<Max_level> level_)
 		{
-			left_nodes(std::move_if_noexcept(left_nodes_));
-			right_nodes(std::move_if_noexcept(right_nodes_));
-			node_value = value;
+			auto new_node = ::new(pool.allocate(level_)) node(level_);
+			std::uninitialized_fill_n(new_node->right_nodes(), level_.get_size(), nullptr);
+			if constexpr (Indexable)
+			{
+				std::uninitialized_fill_n(new_node->widths(), level_.get_size(), size_t{ 0 });
+			}
+			return new_node;
 		}
 
-		void set_null_neighbours(Level<Max_level> level_)
+		template<typename Pool>
+		static void deallocate_node(Pool& pool, node* del_node) noexcept
 		{
-			left_nodes.assign(level_, nullptr);
-			right_nodes.assign(level_, nullptr);
+			const size_t level_ = del_node->level;
+			del_node->~node();
+			pool.deallocate(del_node, level_);
 		}
 
 	public:
-		node() = default;
+		node(const node&) = delete;
+		node& operator=(const node&) = delete;
 
-		template<typename Pair>
-			requires std::is_convertible_v<std::pair< Key, Value>, Pair>
-		node( Pair&& node_value_, const Level<Max_level> level_, const Alloc& alloc = Alloc())
-			: level(level_), allocator(alloc)
+		[[nodiscard]] static constexpr size_t allocation_size(const size_t level_) noexcept
+		{
+			return sizeof(node) + level_ * (sizeof(node*) + (Indexable ? sizeof(size_t) : 0));
+		}
+
+		template<typename Pool, typename Pair>
+			requires std::is_convertible_v<std::pair< Key, Value>, std::remove_cvref_t<Pair>>
+		static node* create(Pool& pool, Pair&& node_value_, const Level<Max_level> level_)
+		{
+			auto new_node = allocate_node(pool, level_);
+			try
+			{
+				std::allocator_traits<Alloc>::construct(pool.get_allocator(), new_node->value_pointer(), std::forward<Pair>(node_value_));
+			}
+			catch (...)
+			{
+				deallocate_node(pool, new_node);
+				throw;
+			}
+			new_node->valid = true;
+			return new_node;
+		}
+
+		template<typename Pool>
+		static node* create_sentinel(Pool& pool, const Level<Max_level> level_)
 		{
-			node_value = std::allocator_traits<Alloc>::allocate(allocator, 1);
-			std::allocator_traits<Alloc>::construct(allocator, node_value, std::forward<Pair>(node_value_));
-			set_null_neighbours(level_);
-			valid = true;
+			return allocate_node(pool, level_);
 		}
 
-		node(const node& other) noexcept
-			: level(other.level), allocator(other.allocator)
+		template<typename Pool>
+		static void destroy(Pool& pool, node* del_node) noexcept
 		{
-			set_null_neighbours(other.level);
-			node_value = std::allocator_traits<Alloc>::allocate(allocator, 1);
-			std::allocator_traits<Alloc>::construct(allocator, node_value, other.node_value->first, other.node_value->second);
-			valid = true;
+			if (del_node->valid)
+			{
+				std::allocator_traits<Alloc>::destroy(pool.get_allocator(), del_node->value_pointer());
+			}
+			deallocate_node(pool, del_node);
 		}
 
-		node(node&& other) noexcept : right_nodes(std::move_if_noexcept(other.right_nodes)), left_nodes (std::move_if_noexcept(other.left_nodes)),
-			node_value(other.node_value), level(std::move_if_noexcept(other.level)), allocator(std::move_if_noexcept(other.allocator))
+		void link_with_left_node(node* left_node_, const size_t index) noexcept
 		{
-			other.node_value = nullptr;
-			other.valid = false;
-			valid = true;
+			auto right_node = left_node_->right_nodes()[index];
+			right_nodes()[index] = right_node;
+			if (index == 0)
+			{
+				left_node = left_node_;
+			}
+			publish_link(left_node_->right_nodes()[index], this);
+			if (index == 0)
+			{
+				publish_link(right_node->left_node, this);
+			}
 		}
 
-		void link_with_left_node(node* left_node, size_t index)
+		void unlink_from_left_node(node* left_node_, const size_t index) noexcept
 		{
-			this->set_left_node(index, left_node);
-			left_node->set_right_node(index, this);
+			auto right_node = right_nodes()[index];
+			publish_link(left_node_->right_nodes()[index], right_node);
+			if (index == 0)
+			{
+				publish_link(right_node->left_node, left_node_);
+			}
 		}
 
-		node& operator=(const node& other)
+		void set_right_node(const size_t index, node* value_)
 		{
-			if (this == &other)
+			if (this == value_) { return; }
+			if (index >= level.get_size())
 			{
-				return *this;
+				throw std::out_of_range("index is larger than node level");
 			}
-			allocator = other.allocator;
-			level = other.level;
-			init_node_value(other.node_value, level);
-			return *this;
+			publish_link(right_nodes()[index], value_);
+		}
+
+		void set_left_node(node* value_) noexcept
+		{
+			publish_link(left_node, value_);
+		}
+
+		[[nodiscard]] bool is_valid() const noexcept
+		{
+			return valid;
+		}
+
+		static void bind_node(node* first, node* second) noexcept
+		{
+			for (size_t index = 0; index < first->level.get_size(); ++index)
+			{
+				publish_link(first->right_nodes()[index], second);
+			}
+			if constexpr (Indexable)
+			{
+				std::fill_n(first->widths(), first->level.get_size(), size_t{ 1 });
+			}
+			publish_link(second->left_node, first);
+		}
+
+		[[nodiscard]] size_t get_width(const size_t index) const noexcept requires Indexable { return widths()[index]; }
+		void set_width(const size_t index, const size_t width) noexcept requires Indexable { widths()[index] = width; }
+
+		[[nodiscard]] size_t distance_to_end() const noexcept requires Indexable
+		{
+			size_t distance = 0;
+			auto current = this;
+			while (current->level.get_size() != 0)
+			{
+				const size_t top = current->level.get_size() - 1;
+				distance += current->get_width(top);
+				current = current->get_right_node(top);
+			}
+			return distance;
+		}
+
+		decltype(auto) get_node_value() { return *value_pointer(); }
+		node* get_right_node(const size_t index) noexcept { return load_link(right_nodes()[index]); }
+		[[nodiscard]] const node* get_right_node(const size_t index) const noexcept { return load_link(right_nodes()[index]); }
+
+		node* next()
+		{
+			if (level.get_size() == 0)
+			{
+				throw std::out_of_range("node has no right neighbour");
+			}
+			return load_link(right_nodes()[0]);
+		}
+
+		[[nodiscard]] const node* next() const { return const_cast<node*>(this)->next(); }
+		node* prev() noexcept { return load_link(left_node); }
+		[[nodiscard]] const node* prev() const noexcept { return load_link(left_node); }
+
+		bool operator==(const node& other) const
+		{
+			return get_key() == other.get_key() && value_pointer()->second == other.value_pointer()->second;
+		}
+
+		[[nodiscard]] Level<Max_level> get_level() const noexcept { return level; }
+		[[nodiscard]] const Key& get_key() const noexcept { return value_pointer()->first; }
+		[[nodiscard]] Value& get_value() noexcept { return value_pointer()->second; }
+		[[nodiscard]] const Value& get_value() const noexcept { return value_pointer()->second; }
+	};
+
+	template <class Alloc>
+	concept polymorphic_allocator = std::is_same_v<Alloc, std::pmr::polymorphic_allocator<typename Alloc::value_type>>;
+
+	template <typename Node, typename Alloc, size_t Max_level>
+	class node_pool final
+	{
+		struct alignas(Node) node_block
+		{
+			unsigned char bytes[alignof(Node)];
+		};
+
+		struct free_block
+		{
+			free_block* next;
+		};
+
+		using block_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<node_block>;
+		using block_traits = std::allocator_traits<block_allocator>;
+
+		Alloc allocator;
+		block_allocator blocks;
+		std::array<free_block*, Max_level + 1> free_lists{};
+
+		[[nodiscard]] static constexpr size_t block_count(const size_t level) noexcept
+		{
+			return (Node::allocation_size(level) + sizeof(node_block) - 1) / sizeof(node_block);
 		}
 
-		node& operator=(node&& other) noexcept
+	public:
+		explicit node_pool(const Alloc& alloc = Alloc()) : allocator(alloc), blocks(alloc) {}
+
+		node_pool(const node_pool&) = delete;
+		node_pool& operator=(const node_pool&) = delete;
+
+		node_pool(node_pool&& other) noexcept : allocator(std::move_if_noexcept(other.allocator)),
+			blocks(std::move_if_noexcept(other.blocks)), free_lists(std::exchange(other.free_lists, {})) {}
+
+		node_pool& operator=(node_pool&& other) noexcept
 		{
 			if (this == &other)
 			{
 				return *this;
 			}
-			level = other.level;
+			release();
 			allocator = std::move_if_noexcept(other.allocator);
-			init_node_value(other.right_nodes, other.left_nodes, other.node_value);
-			other.node_value = nullptr;
+			blocks = std::move_if_noexcept(other.blocks);
+			free_lists = std::exchange(other.free_lists, {});
 			return *this;
 		}
 
-		~node()
+		~node_pool()
+		{
+			release();
+		}
+
+		[[nodiscard]] Alloc& get_allocator() noexcept { return allocator; }
+		[[nodiscard]] const Alloc& get_allocator() const noexcept { return allocator; }
+
+		[[nodiscard]] static constexpr size_t block_bytes(const size_t level) noexcept
+		{
+			return block_count(level) * sizeof(node_block);
+		}
+
+		[[nodiscard]] size_t cached_bytes() const noexcept
 		{
-			if (node_value != nullptr)
+			size_t bytes = 0;
+			for (size_t level = 0; level < free_lists.size(); ++level)
 			{
-				std::allocator_traits<Alloc>::destroy(allocator, node_value);
-				std::allocator_traits<Alloc>::deallocate(allocator, node_value, 1);
+				for (auto block = free_lists[level]; block != nullptr; block = block->next)
+				{
+					bytes += block_bytes(level);
+				}
 			}
+			return bytes;
 		}
 
-		void set_right_node(const size_t index, node* value_) 
+		void* allocate(const size_t level)
 		{
-			if(this == value_){	return;	}
-			right_nodes.at(index) = value_;
+			if (auto block = free_lists[level]; block != nullptr)
+			{
+				free_lists[level] = block->next;
+				return block;
+			}
+			return std::to_address(block_traits::allocate(blocks, block_count(level)));
 		}
 
-		void set_left_node(const size_t index, node* value_) 
+		void deallocate(void* memory, const size_t level) noexcept
 		{
-			if (this == value_) { return; }
-			left_nodes.at(index) = value_;
+			free_lists[level] = ::new(memory) free_block{ free_lists[level] };
 		}
 
-		[[nodiscard]] bool is_valid() const noexcept
+		void release() noexcept
 		{
-			return valid;
+			for (size_t level = 0; level < free_lists.size(); ++level)
+			{
+				while (free_lists[level] != nullptr)
+				{
+					auto block = free_lists[level];
+					free_lists[level] = block->next;
+					block->~free_block();
+					block_traits::deallocate(blocks, std::pointer_traits<typename block_traits::pointer>::pointer_to(
+						*std::launder(reinterpret_cast<node_block*>(block))), block_count(level));
+				}
+			}
 		}
 
-		static void bind_node(node* first, node* second, Level<Max_level> level_) noexcept
+		[[nodiscard]] bool is_monotonic() const noexcept
 		{
-			first->level = level_;
-			second->level = level_;
-			second->right_nodes.assign(level_, nullptr);
-			second->left_nodes.assign(level_, first);
-			first->left_nodes.assign(level_, nullptr);
-			first->right_nodes.assign(level_, second);
+			if constexpr (polymorphic_allocator<Alloc>)
+			{
+				return dynamic_cast<std::pmr::monotonic_buffer_resource*>(allocator.resource()) != nullptr;
+			}
+			return false;
 		}
 
-		decltype(auto) get_node_value() { return *node_value; }
-		node* get_right_node(const size_t  index) noexcept { return right_nodes[index]; }
-		node* get_left_node(const size_t index) noexcept { return left_nodes[index]; }
-		node* next() { return right_nodes.at(0); }
-		[[nodiscard]] const node* next() const { return right_nodes.at(0); }
-		node* prev() { return left_nodes.at(0); }
-		[[nodiscard]] const node* prev() const{ return left_nodes.at(0); }
-
-		bool operator==(const node& other) const
+		void forget() noexcept
 		{
-			return node_value->first == other.node_value->first && node_value->second == other.node_value->second;
+			free_lists = {};
 		}
 
-		[[nodiscard]] Level<Max_level> get_level() const noexcept { return level; }
-		[[nodiscard]] const Key& get_key() const noexcept { return node_value->first; }
-		[[nodiscard]] Value& get_value() noexcept { return node_value->second; }
+		template<bool Propagate = std::allocator_traits<Alloc>::propagate_on_container_swap::value>
+		void swap(node_pool& other) noexcept
+		{
+			if constexpr (Propagate)
+			{
+				std::swap(allocator, other.allocator);
+				std::swap(blocks, other.blocks);
+			}
+			std::swap(free_lists, other.free_lists);
+		}
 	};
 
-	template <bool IsConst, typename Key, typename Value, size_t Max_level = 10, typename Alloc = std::allocator<std::pair<const Key, Value>>>
+	template <bool IsConst, typename Key, typename Value, size_t Max_level = default_max_level,
+		typename Alloc = std::allocator<std::pair<const Key, Value>>, bool Indexable = false, bool Shared_readers = false>
 	class node_iterator final
 	{
-		node<Key, Value, Max_level, Alloc>* list_begin;
-		node<Key, Value, Max_level, Alloc>* list_end;
-		node<Key, Value, Max_level, Alloc>* node_pointer;
+		node<Key, Value, Max_level, Alloc, Indexable, Shared_readers>* list_end;
+		node<Key, Value, Max_level, Alloc, Indexable, Shared_readers>* node_pointer;
 
-		void out_of_range_check(node<Key, Value, Max_level, Alloc>* boundary) const
+		void out_of_range_check(node<Key, Value, Max_level, Alloc, Indexable, Shared_readers>* boundary) const
 		{
 			if (node_pointer == boundary)
 			{
 				throw std::out_of_range("out of range");
 			}
 		}
+
+		void begin_check() const
+		{
+			if (node_pointer == nullptr || node_pointer->prev() == nullptr)
+			{
+				throw std::out_of_range("out of range");
+			}
+		}
 		
-		friend node_iterator<!IsConst, Key, Value, Max_level, Alloc>;
+		friend node_iterator<!IsConst, Key, Value, Max_level, Alloc, Indexable, Shared_readers>;
 	public:
 		using value_type = std::pair<const Key, Value>;
 		using reference = std::pair<const Key, Value>&;
@@ -322,14 +720,13 @@ namespace skip_list_space
 		using iterator_category = std::bidirectional_iterator_tag;
 		using condition_ref = std::conditional_t<IsConst, std::add_const_t<std::remove_reference_t<reference>>&, reference>;
 
-		node_iterator(node<Key, Value, Max_level, Alloc>* begin_, node<Key, Value, Max_level, Alloc>* end_, node<Key, Value, Max_level, Alloc>* node_ptr)
-			:list_begin(begin_), list_end(end_), node_pointer(node_ptr) {}
+		node_iterator(node<Key, Value, Max_level, Alloc, Indexable, Shared_readers>* end_, node<Key, Value, Max_level, Alloc, Indexable, Shared_readers>* node_ptr)
+			:list_end(end_), node_pointer(node_ptr) {}
 
 		template<bool Other_Const>
-			requires !Other_Const || IsConst
-		node_iterator(const node_iterator<Other_Const, Key, Value, Max_level, Alloc>& other)
+			requires (!Other_Const || IsConst)
+		node_iterator(const node_iterator<Other_Const, Key, Value, Max_level, Alloc, Indexable, Shared_readers>& other)
 		{
-			list_begin = other.list_begin;
 			list_end = other.list_end;
 			node_pointer = other.node_pointer;
 		}
@@ -353,6 +750,13 @@ namespace skip_list_space
 			return node_pointer != other.node_pointer;
 		}
 
+		difference_type operator-(const node_iterator& other) const noexcept
+			requires Indexable
+		{
+			return static_cast<difference_type>(other.node_pointer->distance_to_end()) -
+				static_cast<difference_type>(node_pointer->distance_to_end());
+		}
+
 		decltype(auto) get_node_value()
 		{
 			return node_pointer;
@@ -375,7 +779,7 @@ namespace skip_list_space
 
 		decltype(auto) operator--()
 		{
-			out_of_range_check(list_begin);
+			begin_check();
 			node_pointer = node_pointer->prev();
 			return *this;
 		}
@@ -384,18 +788,90 @@ namespace skip_list_space
 	template <valid_Key Key,
 		valid_Value Value,
 		typename Compare = std::less<Key>,
-		size_t Max_level = 10,
-		typename Alloc = std::allocator<std::pair<const Key, Value>>, unsigned int Seed = 5489U>
+		size_t Max_level = default_max_level,
+		typename Alloc = std::allocator<std::pair<const Key, Value>>,
+		level_generator_policy Level_generator = random_tools::level_generator<>,
+		bool Indexable = false,
+		bool Shared_readers = false,
+		bool Statistics = false>
 		requires is_compare<Compare, Key>
 	class skip_list final {
 
-		node<Key, Value, Max_level, Alloc>* head = nullptr;
-		node<Key, Value, Max_level, Alloc>* tail = nullptr;
+		static_assert(!(Indexable && Shared_readers), "span widths cannot be read concurrently with the writer");
+
+		using list_node = node<Key, Value, Max_level, Alloc, Indexable, Shared_readers>;
+
+		struct reader_state
+		{
+			std::unique_ptr<epoch_domain> domain = std::make_unique<epoch_domain>();
+			std::vector<std::pair<list_node*, uint64_t>> retired;
+		};
+
+		struct no_reader_state {};
+
+		list_node* head = nullptr;
+		list_node* tail = nullptr;
 		Compare compare;
-		Alloc allocator;
+		node_pool<list_node, Alloc, Max_level> pool;
 		size_t list_size{};
-		std::mt19937 random_number_generator{Seed};
+		Level_generator level_generator{};
 		Level<Max_level> list_lvl{};
+		size_t growth_size = initial_growth_size();
+		std::vector<list_node*> finger;
+		std::vector<size_t> finger_ranks;
+		SKIP_LIST_NO_UNIQUE_ADDRESS std::conditional_t<Shared_readers, reader_state, no_reader_state> readers;
+		SKIP_LIST_NO_UNIQUE_ADDRESS std::conditional_t<Statistics, operation_counters, no_operation_counters> counters;
+
+		static constexpr size_t initial_head_lvl = Shared_readers ? Max_level : std::min<size_t>(Max_level, 4);
+		static constexpr size_t reclaim_period = 64;
+		static constexpr size_t lookup_group_size = 16;
+
+		[[nodiscard]] static constexpr size_t next_growth_size(const size_t size) noexcept
+		{
+			using probability = typename promotion_probability<Level_generator>::type;
+			const double next_size = std::ceil(static_cast<double>(size) * probability::den / probability::num);
+			return next_size >= static_cast<double>(std::numeric_limits<size_t>::max())
+				? std::numeric_limits<size_t>::max() : static_cast<size_t>(next_size);
+		}
+
+		[[nodiscard]] static constexpr size_t growth_size_for(const size_t head_lvl) noexcept
+		{
+			size_t size = 1;
+			for (size_t lvl = 1; lvl < head_lvl; ++lvl)
+			{
+				size = next_growth_size(size);
+			}
+			return size;
+		}
+
+		[[nodiscard]] static constexpr size_t initial_growth_size() noexcept
+		{
+			return growth_size_for(initial_head_lvl);
+		}
+
+		void grow_head()
+		{
+			if (head->get_level() >= Max_level)
+			{
+				growth_size = std::numeric_limits<size_t>::max();
+				return;
+			}
+			const Level<Max_level> new_lvl = head->get_level().get_size() + 1;
+			auto new_head = list_node::create_sentinel(pool, new_lvl);
+			for (size_t index = 0; index < new_lvl; ++index)
+			{
+				new_head->set_right_node(index, index < head->get_level() ? head->get_right_node(index) : tail);
+				if constexpr (Indexable)
+				{
+					new_head->set_width(index, index < head->get_level() ? head->get_width(index) : list_size + 1);
+				}
+			}
+			new_head->get_right_node(0)->set_left_node(new_head);
+			std::replace(finger.begin(), finger.end(), head, new_head);
+			list_node::destroy(pool, head);
+			head = new_head;
+			growth_size = next_growth_size(growth_size);
+		}
 
 		template<typename Key_ = Key>
 		[[nodiscard]] bool equal_key(const Key_& first, const Key_& second) const
@@ -410,411 +886,2996 @@ namespace skip_list_space
 			return std::fabs(first - second) < std::numeric_limits<Key_>::epsilon();
 		}
 
-		void insert_sorted_nodes(node<Key, Value, Max_level, Alloc>* nodes_head, node<Key, Value, Max_level, Alloc>* nodes_tail)
+		template<bool Move = false>
+		void insert_sorted_nodes(list_node* nodes_head, list_node* nodes_tail)
 		{
-			std::vector<node<Key, Value, Max_level, Alloc>*> array_no_linked_nodes;
+			std::vector<list_node*> array_no_linked_nodes;
 			array_no_linked_nodes.assign(Max_level, head);
 			for (auto inserted_node = nodes_head->next(); inserted_node != nodes_tail; inserted_node = inserted_node->next())
 			{
-				auto new_node = new node<Key, Value, Max_level, Alloc>(*inserted_node);
+				using source_value = std::conditional_t<Move, std::pair<const Key, Value>&&, std::pair<const Key, Value>&>;
+				auto new_node = list_node::create(pool, static_cast<source_value>(inserted_node->get_node_value()), inserted_node->get_level());
 				for (Level<Max_level> index = 0; index < new_node->get_level(); ++index)
 				{
 					new_node->link_with_left_node(array_no_linked_nodes[index], index);
 					array_no_linked_nodes[index] = new_node;
+					if constexpr (Indexable)
+					{
+						new_node->set_width(index, inserted_node->get_width(index));
+					}
 				}
 			}
-			for (size_t index = 0; index < Max_level; ++index)
+			if constexpr (Indexable)
 			{
-				tail->link_with_left_node(array_no_linked_nodes[index], index);
+				for (size_t index = 0; index < head->get_level(); ++index)
+				{
+					head->set_width(index, nodes_head->get_width(index));
+				}
 			}
 		}
 
-		decltype(auto) next_less_key_element(node<Key, Value,Max_level, Alloc>* node, int lvl_index,const Key& key) const
+		template<class Pair>
+		void append_sorted_node(Pair&& value, std::vector<list_node*>& last_nodes, std::vector<size_t>& last_ranks)
 		{
-			while (node->get_right_node(lvl_index) != tail &&
-				compare(node->get_right_node(lvl_index)->get_key(), key))
-			{
-				node = node->get_right_node(lvl_index);
-			}
-			return node;
+			append_sorted_node(std::forward<Pair>(value), random_level(), last_nodes, last_ranks);
 		}
 
-		decltype(auto) search_key_storing_past_elements(const Key& key, const Level<Max_level> level)
+		template<class Pair>
+		void append_sorted_node(Pair&& value, const Level<Max_level> level, std::vector<list_node*>& last_nodes, std::vector<size_t>& last_ranks)
 		{
-			std::vector<node<Key, Value, Max_level, Alloc>*> past_elements;
-			past_elements.assign(Max_level, nullptr);
-			auto node = head;
-			for (int lvl_index = static_cast<int>(level.get_size()) - 1; lvl_index >= 0; --lvl_index)
+			while (level > head->get_level())
+			{
+				auto old_head = head;
+				grow_head();
+				std::replace(last_nodes.begin(), last_nodes.end(), old_head, head);
+			}
+			auto new_node = list_node::create(pool, std::forward<Pair>(value), level);
+			for (Level<Max_level> index = 0; index < level; ++index)
 			{
-				node = next_less_key_element(node, lvl_index, key);
-				past_elements[lvl_index] = node;
+				new_node->link_with_left_node(last_nodes[index], index);
+				if constexpr (Indexable)
+				{
+					last_nodes[index]->set_width(index, list_size + 1 - last_ranks[index]);
+					last_ranks[index] = list_size + 1;
+				}
+				last_nodes[index] = new_node;
+			}
+			if (level > list_lvl){list_lvl = level;}
+			counters.count_insert();
+			if (++list_size >= growth_size)
+			{
+				auto old_head = head;
+				grow_head();
+				std::replace(last_nodes.begin(), last_nodes.end(), old_head, head);
 			}
-			return past_elements;
 		}
 
-		[[nodiscard]] node<Key, Value, Max_level, Alloc>* search_key(const Key& key) const
+		void start_sorted_build(std::vector<list_node*>& last_nodes, std::vector<size_t>& last_ranks)
 		{
-			auto node = head;
-			for (int lvl_index = static_cast<int>(list_lvl.get_size()) - 1; lvl_index >= 0; --lvl_index)
+			if (head == nullptr)
 			{
-				node = next_less_key_element(node, lvl_index, key);
+				init_head_and_tail();
 			}
-			if (list_size != 0)
+			else
 			{
-				if (equal_key(node->next()->get_key(), key))
-				{
-					return node->next();
-				}
+				clear();
 			}
-			return tail;
+			last_nodes.assign(Max_level, head);
+			last_ranks.assign(Max_level, 0);
 		}
 
-		[[nodiscard]] Level<Max_level> find_max_lvl() const noexcept
+		void finish_sorted_build(const std::vector<list_node*>& last_nodes, const std::vector<size_t>& last_ranks)
 		{
-			Level<Max_level> max = 0;
-			for (const_iterator list_node = cbegin(); list_node != cend(); ++list_node)
+			if constexpr (Indexable)
 			{
-				auto new_max = list_node.get_node_value()->get_level();
-				if (new_max > max)
+				for (size_t index = 0; index < head->get_level(); ++index)
 				{
-					max = new_max;
+					last_nodes[index]->set_width(index, list_size + 1 - last_ranks[index]);
 				}
 			}
-			return max;
 		}
 
-		void delete_node(node<Key, Value, Max_level, Alloc>* del_node)
+		template<std::input_iterator InputIt, std::sentinel_for<InputIt> Sentinel>
+		void build_sorted(InputIt first, Sentinel last)
 		{
-			if (del_node != head && del_node != tail)
+			std::vector<list_node*> last_nodes;
+			std::vector<size_t> last_ranks;
+			start_sorted_build(last_nodes, last_ranks);
+			for (; first != last; ++first)
 			{
-				Level<Max_level> lvl = del_node->get_level();
-				for (Level < Max_level> lvl_index = 0; lvl_index < lvl; ++lvl_index)
-				{
-					auto next_element = del_node->get_right_node(lvl_index);
-					auto prev_element = del_node->get_left_node(lvl_index);
-					next_element->link_with_left_node( prev_element, lvl_index);
-				}
-				list_size -= 1;
-				list_lvl = find_max_lvl();
+				append_sorted_node(*first, last_nodes, last_ranks);
 			}
-
-			delete del_node;
+			finish_sorted_build(last_nodes, last_ranks);
 		}
 
-		void delete_list()
+		static constexpr uint32_t serialization_magic = 0x4C504B53;
+		static constexpr uint32_t serialization_version = 1;
+
+		template<typename Writer>
+		void save_to(Writer& out) const
 		{
-			if(head == nullptr || tail == nullptr)
+			static_assert(Max_level <= UINT8_MAX, "node levels are stored in a single byte");
+			serializer<uint32_t>::write(out, serialization_magic);
+			serializer<uint32_t>::write(out, serialization_version);
+			serializer<uint64_t>::write(out, static_cast<uint64_t>(list_size));
+			if (head == nullptr)
 			{
 				return;
 			}
-			auto del_node = head;
-			auto next_node = head->next();
-			if (next_node == tail)
+			for (const list_node* current = head->next(); current != tail; current = current->next())
 			{
-				delete head;
+				serializer<uint8_t>::write(out, static_cast<uint8_t>(current->get_level().get_size()));
+				serializer<Key>::write(out, current->get_key());
+				serializer<Value>::write(out, current->get_value());
 			}
-			else
+		}
+
+		template<typename Reader>
+		void load_from(Reader& in)
+		{
+			std::vector<list_node*> last_nodes;
+			std::vector<size_t> last_ranks;
+			start_sorted_build(last_nodes, last_ranks);
+			try
 			{
-				while (del_node != tail)
+				if (serializer<uint32_t>::read(in) != serialization_magic || serializer<uint32_t>::read(in) != serialization_version)
+				{
+					throw std::runtime_error("not a serialized skip list");
+				}
+				const auto count = serializer<uint64_t>::read(in);
+				for (uint64_t index = 0; index < count; ++index)
 				{
-					delete del_node;
-					del_node = next_node;
-					next_node = next_node->next();
+					const size_t stored_lvl = serializer<uint8_t>::read(in);
+					if (stored_lvl == 0)
+					{
+						throw std::runtime_error("serialized skip list has a node without levels");
+					}
+					std::pair<Key, Value> value{ serializer<Key>::read(in), serializer<Value>::read(in) };
+					if (index != 0 && !compare(last_nodes[0]->get_key(), value.first))
+					{
+						throw std::runtime_error("serialized skip list is not sorted");
+					}
+					append_sorted_node(std::move(value), Level<Max_level>(std::min(stored_lvl, Max_level)), last_nodes, last_ranks);
 				}
 			}
-			delete tail;
-			list_size = 0;
-			list_lvl = 0;
+			catch (...)
+			{
+				clear();
+				throw;
+			}
+			finish_sorted_build(last_nodes, last_ranks);
 		}
 
-		void init_head_and_tail()
+		template<std::input_iterator InputIt, std::sentinel_for<InputIt> Sentinel>
+		void build(InputIt first, Sentinel last)
 		{
-			head = new node<Key, Value, Max_level, Alloc>;
-			tail = new node<Key, Value, Max_level, Alloc>;
-			node<Key, Value, Max_level, Alloc>::bind_node(head, tail, Max_level);
+			const auto key_less = [this](const auto& first_value, const auto& second_value)
+			{
+				return compare(first_value.first, second_value.first);
+			};
+			if constexpr (std::forward_iterator<InputIt>)
+			{
+				if (std::ranges::adjacent_find(first, last, [&key_less](const auto& first_value, const auto& second_value)
+					{
+						return !key_less(first_value, second_value);
+					}) == last)
+				{
+					build_sorted(first, last);
+					return;
+				}
+			}
+			std::vector<std::pair<Key, Value>> values(first, last);
+			std::stable_sort(values.begin(), values.end(), key_less);
+			values.erase(std::unique(values.begin(), values.end(), [this](const auto& first_value, const auto& second_value)
+				{
+					return equal_key(first_value.first, second_value.first);
+				}), values.end());
+			build_sorted(std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
 		}
 
-	public:
-		using iterator = node_iterator<false, Key, Value, Max_level, Alloc>;
-		using const_iterator = node_iterator<true, Key, Value, Max_level, Alloc>;
-		using reverse_iterator = std::reverse_iterator<iterator>;
-		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
-		using value_type = std::pair<const Key, Value>;
-		using size_type = size_t;
+		template <typename Probe>
+		decltype(auto) next_less_key_element(list_node* node, int lvl_index, const Key& key, Probe& probe) const
+		{
+			return skip_list_space::next_less_key_element(node, lvl_index, key, tail, compare, probe);
+		}
 
-		explicit skip_list(const Compare& comp = Compare(), const Alloc& alloc = Alloc()) : compare(comp), allocator(alloc)	{}
+		template <typename Probe>
+		decltype(auto) next_less_key_element(list_node* node, int lvl_index, const Key& key, size_t& rank, Probe& probe) const
+			requires Indexable
+		{
+			for (auto right_node = node->get_right_node(lvl_index); right_node != tail; right_node = node->get_right_node(lvl_index))
+			{
+				probe.compared();
+				if (!compare(right_node->get_key(), key))
+				{
+					break;
+				}
+				probe.visited();
+				rank += node->get_width(lvl_index);
+				node = right_node;
+			}
+			return node;
+		}
 
-		explicit skip_list(const std::initializer_list<value_type>& list, const Compare& comp = Compare(), const Alloc& alloc = Alloc())
-		: skip_list(comp, alloc)
+		void reset_finger()
 		{
-			init_head_and_tail();
-			for(const auto& inserted_value : list)
+			if (head == nullptr)
+			{
+				finger.clear();
+				finger_ranks.clear();
+				return;
+			}
+			finger.assign(Max_level, head);
+			if constexpr (Indexable)
 			{
-				insert(inserted_value);
+				finger_ranks.assign(Max_level, 0);
 			}
 		}
 
-		~skip_list()
+		[[nodiscard]] bool finger_before_key(const list_node* node, const Key& key) const
 		{
-			delete_list();
+			return node == head || compare(node->get_key(), key);
 		}
 
-		skip_list(const skip_list& another) : compare(another.compare), allocator(another.allocator),
-			list_size(another.list_size), list_lvl(another.list_lvl)
+		const std::vector<list_node*>& search_key_storing_past_elements(const Key& key)
 		{
-			if (!another.empty())
+			const size_t top = list_lvl.get_size();
+			if (top == 0)
 			{
-				init_head_and_tail();
-				insert_sorted_nodes(another.head, another.tail);
+				return finger;
+			}
+			size_t start_lvl = 0;
+			if (finger_before_key(finger[0], key))
+			{
+				while (start_lvl + 1 < top && finger[start_lvl + 1]->get_right_node(start_lvl + 1) != tail &&
+					compare(finger[start_lvl + 1]->get_right_node(start_lvl + 1)->get_key(), key))
+				{
+					++start_lvl;
+				}
+			}
+			else
+			{
+				while (start_lvl < top && !finger_before_key(finger[start_lvl], key))
+				{
+					++start_lvl;
+				}
+				if (start_lvl == top)
+				{
+					start_lvl = top - 1;
+					finger[start_lvl] = head;
+					if constexpr (Indexable)
+					{
+						finger_ranks[start_lvl] = 0;
+					}
+				}
+			}
+			auto node = finger[start_lvl];
+			size_t rank = 0;
+			if constexpr (Indexable)
+			{
+				rank = finger_ranks[start_lvl];
 			}
+			auto probe = counters.start_search();
+			for (int lvl_index = static_cast<int>(start_lvl); lvl_index >= 0; --lvl_index)
+			{
+				if constexpr (Indexable)
+				{
+					node = next_less_key_element(node, lvl_index, key, rank, probe);
+					finger_ranks[lvl_index] = rank;
+				}
+				else
+				{
+					node = next_less_key_element(node, lvl_index, key, probe);
+				}
+				finger[lvl_index] = node;
+			}
+			return finger;
 		}
 
-		skip_list(skip_list&& another) noexcept : head(another.head), tail(another.tail),compare(std::move_if_noexcept(another.compare)),
-			allocator(std::move_if_noexcept(another.allocator)),list_size(another.list_size), list_lvl(another.list_lvl)
+		void advance_finger(list_node* new_node) noexcept
 		{
-			another.list_lvl = 0;
-			another.list_size = 0;
-			another.head = nullptr;
-			another.tail = nullptr;
+			size_t position = 0;
+			if constexpr (Indexable)
+			{
+				position = finger_ranks[0] + 1;
+			}
+			for (size_t index = 0; index < new_node->get_level(); ++index)
+			{
+				finger[index] = new_node;
+				if constexpr (Indexable)
+				{
+					finger_ranks[index] = position;
+				}
+			}
 		}
 
-		skip_list& operator=(const skip_list& another) noexcept
+		[[nodiscard]] list_node* search_key_from_finger(const Key& key)
 		{
-			if (this == &another)
+			if (head == nullptr)
 			{
-				return *this;
+				return tail;
 			}
-			delete_list();
-			compare = another.compare;
-			allocator = another.allocator;
-			list_lvl = another.list_lvl;
-			list_size = another.list_size;
-			if (!another.empty())
+			auto node = search_key_storing_past_elements(key)[0]->get_right_node(0);
+			if (node != tail && equal_key(node->get_key(), key))
 			{
-				init_head_and_tail();
-				insert_sorted_nodes(another.head, another.tail);
+				return node;
 			}
-			return *this;
+			return tail;
 		}
 
-		skip_list& operator=(skip_list&& another) noexcept
+		[[nodiscard]] list_node* lookup_node(const Key& key)
 		{
-			if (this == &another)
+			if constexpr (Shared_readers)
 			{
-				return *this;
+				return search_key(key);
+			}
+			else
+			{
+				return search_key_from_finger(key);
 			}
-			compare = std::move_if_noexcept(another.compare);
-			allocator = std::move_if_noexcept(another.allocator);
-			list_size = another.list_size;
-			list_lvl = another.list_lvl;
-			std::swap(head, another.head);
-			std::swap(tail, another.tail);
-			return *this;
 		}
 
-		iterator begin()
+		void update_widths_after_insert(const std::vector<list_node*>& updated_nods, const std::vector<size_t>& past_ranks,
+			list_node* new_node) noexcept requires Indexable
 		{
-			if(head == nullptr){return end();}
-			return iterator(head, tail, head->next());
+			const size_t position = past_ranks[0] + 1;
+			for (size_t index = 0; index < head->get_level(); ++index)
+			{
+				const size_t old_width = updated_nods[index]->get_width(index);
+				if (index < new_node->get_level())
+				{
+					updated_nods[index]->set_width(index, position - past_ranks[index]);
+					new_node->set_width(index, past_ranks[index] + old_width + 1 - position);
+				}
+				else
+				{
+					updated_nods[index]->set_width(index, old_width + 1);
+				}
+			}
 		}
 
-		iterator end() { return iterator(head, tail, tail); }
-
-		[[nodiscard]] const_iterator cbegin() const
+		[[nodiscard]] size_t search_lvl() const noexcept
 		{
-			if (head == nullptr){return cend();}
-			return const_iterator(head, tail, head->next());
+			if constexpr (Shared_readers)
+			{
+				return head->get_level().get_size();
+			}
+			else
+			{
+				return list_lvl.get_size();
+			}
 		}
 
-		[[nodiscard]] const_iterator cend() const { return const_iterator(head, tail, tail); }
-
-		[[nodiscard]] bool empty() const
+		[[nodiscard]] list_node* search_key(const Key& key) const
 		{
-			return list_size == static_cast<size_t>(0);
+			auto candidate = search_lower_bound(key);
+			if (candidate != tail && equal_key(candidate->get_key(), key))
+			{
+				return candidate;
+			}
+			return tail;
 		}
 
-		[[nodiscard]] size_t size() const { return list_size; }
-
-		Value& operator[](const Key& key)
-			requires std::is_default_constructible_v<Value>
+		template <typename Key_iterator, typename Visitor>
+		void search_keys_interleaved(Key_iterator first, const Key_iterator last, Visitor&& visit) const
 		{
-			auto searched_key = search_key(key);
-			if (searched_key == tail)
+			std::array<Key_iterator, lookup_group_size> keys{};
+			std::array<list_node*, lookup_group_size> nodes{};
+			std::array<size_t, lookup_group_size> levels{};
+			std::array<list_node*, lookup_group_size> found_nodes{};
+			while (first != last)
 			{
-				Value new_value{};
-				auto new_node = insert(std::make_pair(key, new_value));
-				return (*new_node.first).second;
+				size_t group = 0;
+				for (; group < lookup_group_size && first != last; ++group, ++first)
+				{
+					keys[group] = first;
+					nodes[group] = head;
+					levels[group] = search_lvl();
+					found_nodes[group] = head == nullptr ? tail : head->get_right_node(0);
+				}
+				if (head == nullptr)
+				{
+					for (size_t index = 0; index < group; ++index)
+					{
+						visit(tail);
+					}
+					continue;
+				}
+				auto probe = counters.start_search(group);
+				size_t active = group;
+				while (active != 0)
+				{
+					active = 0;
+					for (size_t index = 0; index < group; ++index)
+					{
+						if (levels[index] == 0)
+						{
+							continue;
+						}
+						auto right_node = nodes[index]->get_right_node(levels[index] - 1);
+						if (right_node != tail && (probe.compared(), compare(right_node->get_key(), *keys[index])))
+						{
+							probe.visited();
+							nodes[index] = right_node;
+						}
+						else if (--levels[index] == 0)
+						{
+							found_nodes[index] = right_node;
+							continue;
+						}
+						prefetch_node(nodes[index]->get_right_node(levels[index] - 1));
+						++active;
+					}
+				}
+				for (size_t index = 0; index < group; ++index)
+				{
+					auto found_node = found_nodes[index];
+					visit(found_node != tail && equal_key(found_node->get_key(), *keys[index]) ? found_node : tail);
+				}
 			}
-			return searched_key->get_value();
 		}
 
-		[[nodiscard]] const Value& at(const Key& key) const
+		[[nodiscard]] list_node* search_lower_bound(const Key& key) const
 		{
-			node<Key, Value, Max_level, Alloc>* searched_key = search_key(key);
-			if (searched_key == tail)
+			if (head == nullptr)
 			{
-				throw std::out_of_range("Out of range!");
+				return tail;
 			}
-			auto& value = searched_key->get_value();
-			return value;
+			auto node = head;
+			auto right_node = head->get_right_node(0);
+			auto probe = counters.start_search();
+			for (int lvl_index = static_cast<int>(search_lvl()) - 1; lvl_index >= 0; --lvl_index)
+			{
+				right_node = node->get_right_node(lvl_index);
+				while (right_node != tail && (probe.compared(), compare(right_node->get_key(), key)))
+				{
+					probe.visited();
+					node = right_node;
+					right_node = node->get_right_node(lvl_index);
+				}
+			}
+			return right_node;
 		}
 
-		Value& at(const Key& key)
+		[[nodiscard]] list_node* search_upper_bound(const Key& key) const
 		{
-			return const_cast<Value&>(const_cast<const skip_list*>(this)->at(key));
+			if (head == nullptr)
+			{
+				return tail;
+			}
+			auto node = head;
+			auto right_node = head->get_right_node(0);
+			auto probe = counters.start_search();
+			for (int lvl_index = static_cast<int>(search_lvl()) - 1; lvl_index >= 0; --lvl_index)
+			{
+				right_node = node->get_right_node(lvl_index);
+				while (right_node != tail && (probe.compared(), !compare(key, right_node->get_key())))
+				{
+					probe.visited();
+					node = right_node;
+					right_node = node->get_right_node(lvl_index);
+				}
+			}
+			return right_node;
 		}
 
-		template<class Pair>
-			requires std::is_convertible_v<std::pair<Key, Value>, Pair>
-		std::pair<iterator, bool> insert(Pair&& value_nods)
+		[[nodiscard]] list_node* search_index(const size_t index) const requires Indexable
 		{
-			Level<Max_level> level = random_tools::random_level(Max_level, random_number_generator);
-			if (head == nullptr && tail == nullptr)
+			if (index >= list_size)
 			{
-				init_head_and_tail();
+				return tail;
 			}
-			auto updated_nods = search_key_storing_past_elements(value_nods.first, level);
-			auto found_element = updated_nods[0]->next();
-			if (found_element != tail)
+			auto node = head;
+			size_t position = 0;
+			for (int lvl_index = static_cast<int>(search_lvl()) - 1; lvl_index >= 0; --lvl_index)
 			{
-				if (equal_key<Key>(found_element->get_key(), value_nods.first))
+				while (node->get_right_node(lvl_index) != tail && position + node->get_width(lvl_index) <= index + 1)
 				{
-					return std::pair<iterator, bool>(iterator(head, tail, found_element), false);
+					position += node->get_width(lvl_index);
+					node = node->get_right_node(lvl_index);
 				}
 			}
-			auto new_node = new node<Key, Value, Max_level, Alloc>(std::forward<Pair>(value_nods), level);
-			for (Level<Max_level> index = 0; index < level; ++index)
+			return node;
+		}
+
+		void shrink_list_lvl() noexcept
+		{
+			size_t lvl = list_lvl.get_size();
+			while (lvl > 0 && head->get_right_node(lvl - 1) == tail)
 			{
-				new_node->link_with_left_node(updated_nods[index], index);
-				updated_nods[index]->get_right_node(index)->link_with_left_node(new_node, index);
-				
+				--lvl;
 			}
-			if (level > list_lvl){list_lvl = level;}
-			++list_size;
-			return std::pair<iterator, bool>(iterator(head, tail, new_node), true);
+			list_lvl.set_size(lvl);
 		}
 
-		void erase(iterator position)
+		void delete_node(list_node* del_node)
 		{
-			if (position.get_node_value() == tail)
+			if (del_node == head || del_node == tail)
 			{
 				return;
 			}
-			delete_node(position.get_node_value());
+			const auto lvl = static_cast<int>(del_node->get_level().get_size());
+			search_key_storing_past_elements(del_node->get_key());
+			counters.count_erase();
+			for (int lvl_index = static_cast<int>(list_lvl.get_size()) - 1; lvl_index >= 0; --lvl_index)
+			{
+				auto node = finger[lvl_index];
+				if (lvl_index < lvl)
+				{
+					if constexpr (Indexable)
+					{
+						node->set_width(lvl_index, node->get_width(lvl_index) + del_node->get_width(lvl_index) - 1);
+					}
+					del_node->unlink_from_left_node(node, lvl_index);
+				}
+				else if constexpr (Indexable)
+				{
+					node->set_width(lvl_index, node->get_width(lvl_index) - 1);
+				}
+			}
+			if constexpr (Indexable)
+			{
+				for (size_t index = list_lvl; index < head->get_level(); ++index)
+				{
+					head->set_width(index, head->get_width(index) - 1);
+				}
+			}
+			list_size -= 1;
+			release_node(del_node);
+			shrink_list_lvl();
 		}
 
-		size_type erase(const Key& key)
+		size_t destroy_nodes(list_node* first, list_node* last) noexcept
 		{
-			auto del_element = search_key(key);
-			if (del_element != tail)
+			size_t count = 0;
+			while (first != last)
 			{
-				delete_node(del_element);
+				auto next_node = first->get_right_node(0);
+				list_node::destroy(pool, first);
+				first = next_node;
+				++count;
 			}
-			return list_size;
+			return count;
 		}
 
-		void erase(iterator first, iterator last)
+		void reclaim_retired_nodes() noexcept requires Shared_readers
 		{
-			if (first == last)
+			if (readers.domain == nullptr)
 			{
 				return;
 			}
-			for (auto iterator_ = first; iterator_ != last;)
+			readers.domain->try_advance();
+			const uint64_t epoch = readers.domain->current_epoch();
+			auto last_safe = std::find_if(readers.retired.begin(), readers.retired.end(), [epoch](const auto& retired_node)
+				{
+					return retired_node.second + 2 > epoch;
+				});
+			for (auto retired_node = readers.retired.begin(); retired_node != last_safe; ++retired_node)
 			{
-				erase(iterator_++);
+				list_node::destroy(pool, retired_node->first);
 			}
+			readers.retired.erase(readers.retired.begin(), last_safe);
 		}
 
-		void swap(skip_list& another) noexcept
+		void release_node(list_node* del_node)
 		{
-			if(this == &another)
+			if constexpr (Shared_readers)
 			{
-				return;
+				readers.retired.emplace_back(del_node, readers.domain->current_epoch());
+				if (readers.retired.size() % reclaim_period == 0)
+				{
+					reclaim_retired_nodes();
+				}
+			}
+			else
+			{
+				list_node::destroy(pool, del_node);
 			}
-			std::swap(list_lvl, another.list_lvl);
-			std::swap(list_size, another.list_size);
-			std::swap(allocator, another.allocator);
-			std::swap(compare, another.compare);
-			std::swap(head, another.head);
-			std::swap(tail, another.tail);
 		}
 
-		void clear()
+		size_t release_nodes(list_node* first, list_node* last)
 		{
-			erase(begin(), end());
+			size_t count = 0;
+			while (first != last)
+			{
+				auto next_node = first->get_right_node(0);
+				release_node(first);
+				first = next_node;
+				++count;
+			}
+			return count;
 		}
 
-		[[nodiscard]] const_iterator find(const Key& key) const
+		void delete_list()
 		{
-			auto searched_node = search_key(key);
-			if (searched_node == tail)
+			if(head == nullptr || tail == nullptr)
 			{
-				return const_iterator(head, tail, tail);
+				return;
 			}
-			if (equal_key(searched_node->get_key(), key))
+			if (std::is_trivially_destructible_v<value_type> && pool.is_monotonic())
 			{
-				return const_iterator(head, tail, searched_node);
+				pool.forget();
 			}
-			return const_iterator(head, tail, tail);
-		}
-
-		iterator find(const Key& key)
-		{
-			auto searched_node = search_key(key);
-			if (searched_node == tail)
+			else
 			{
-				return iterator(head, tail, tail);
+				destroy_nodes(head, tail);
+				list_node::destroy(pool, tail);
+				if constexpr (Shared_readers)
+				{
+					for (const auto& retired_node : readers.retired)
+					{
+						list_node::destroy(pool, retired_node.first);
+					}
+				}
 			}
-			if (equal_key(searched_node->get_key(), key))
+			if constexpr (Shared_readers)
 			{
-				return iterator(head, tail, searched_node);
+				readers.retired.clear();
 			}
-			return iterator(head, tail, tail);
+			head = nullptr;
+			tail = nullptr;
+			list_size = 0;
+			list_lvl = 0;
+			reset_finger();
+		}
+
+		[[nodiscard]] Level<Max_level> random_level()
+		{
+			return Level<Max_level>(std::clamp<size_t>(level_generator(head->get_level()), 1, head->get_level()));
 		}
 
-		reverse_iterator rbegin() { return reverse_iterator(iterator(head, tail, tail)); }
-		reverse_iterator rend() { return reverse_iterator(iterator(head, tail, head->next())); }
-		[[nodiscard]] const_reverse_iterator rbegin() const { return const_reverse_iterator(const_iterator(head, tail, tail)); }
-		[[nodiscard]] const_reverse_iterator rend() const { return const_reverse_iterator(const_iterator(head, tail, head->next())); }
+		static constexpr bool allocators_always_equal = std::allocator_traits<Alloc>::is_always_equal::value;
+		static constexpr bool propagate_on_copy = std::allocator_traits<Alloc>::propagate_on_container_copy_assignment::value;
+		static constexpr bool propagate_on_move = std::allocator_traits<Alloc>::propagate_on_container_move_assignment::value;
+		static constexpr bool propagate_on_swap = std::allocator_traits<Alloc>::propagate_on_container_swap::value;
 
-		[[nodiscard]] size_type count(const Key& key) const
+		void move_nodes_from(skip_list& another)
 		{
-			auto searched_node = search_key(key);
-			if (searched_node == tail)
+			delete_list();
+			if (!another.empty())
 			{
-				return 0;
+				init_head_and_tail(another.head->get_level());
+				insert_sorted_nodes<true>(another.head, another.tail);
+				list_size = another.list_size;
+				list_lvl = another.list_lvl;
 			}
-			return 1;
+			else if constexpr (Shared_readers)
+			{
+				init_head_and_tail();
+			}
+			another.clear();
 		}
 
-		template <size_t Other_Max_level>
-			requires comparable_value<Value>
-		bool operator==(const skip_list<Key, Value, Compare, Other_Max_level, Alloc>& another) const
+		void init_head_and_tail(const Level<Max_level> head_lvl = initial_head_lvl)
 		{
-			if (another.size() != list_size || empty() || another.empty())
-			{
-				return false;
-			}
-			auto another_node = another.cbegin();
-			auto node = cbegin();
-			for (size_t index = 0; index != list_size; ++index)
+			if constexpr (Shared_readers)
 			{
-				if (!equal_key((*node).first, (*another_node).first) ||
-					(*node).second != (*another_node).second)
+				if (readers.domain == nullptr)
 				{
-					return false;
+					readers.domain = std::make_unique<epoch_domain>();
 				}
-				++node;
-				++another_node;
 			}
-			return true;
+			growth_size = growth_size_for(head_lvl);
+			head = list_node::create_sentinel(pool, head_lvl);
+			tail = list_node::create_sentinel(pool, 0);
+			list_node::bind_node(head, tail);
+			reset_finger();
 		}
 
-		template <size_t Other_Max_level>
-			requires comparable_value<Value>
-		bool operator!=(const skip_list<Key, Value, Compare, Other_Max_level, Alloc>& another) const
+	public:
+		using iterator = node_iterator<false, Key, Value, Max_level, Alloc, Indexable, Shared_readers>;
+		using const_iterator = node_iterator<true, Key, Value, Max_level, Alloc, Indexable, Shared_readers>;
+		using reverse_iterator = std::reverse_iterator<iterator>;
+		using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+		using value_type = std::pair<const Key, Value>;
+		using size_type = size_t;
+
+		template<bool IsConst>
+		class range_view final
+		{
+			using view_iterator = std::conditional_t<IsConst, const_iterator, iterator>;
+
+			struct sentinel
+			{
+				const Compare* compare;
+				Key upper_key;
+				list_node* end_node;
+
+				friend bool operator==(view_iterator position, const sentinel& last)
+				{
+					auto node = position.get_node_value();
+					return node == last.end_node || !(*last.compare)(node->get_key(), last.upper_key);
+				}
+			};
+
+			view_iterator first;
+			sentinel last;
+
+		public:
+			range_view(view_iterator first_, const Compare* compare_, const Key& upper_key, list_node* end_node)
+				: first(first_), last{ compare_, upper_key, end_node } {}
+
+			[[nodiscard]] view_iterator begin() const { return first; }
+			[[nodiscard]] sentinel end() const { return last; }
+			[[nodiscard]] bool empty() const { return first == last; }
+		};
+
+		explicit skip_list(const Compare& comp = Compare(), const Alloc& alloc = Alloc()) : compare(comp), pool(alloc)
+		{
+			if constexpr (Shared_readers)
+			{
+				init_head_and_tail();
+			}
+		}
+
+		explicit skip_list(const Alloc& alloc) : skip_list(Compare(), alloc) {}
+
+		explicit skip_list(const std::initializer_list<value_type>& list, const Compare& comp = Compare(), const Alloc& alloc = Alloc())
+		: skip_list(list.begin(), list.end(), comp, alloc) {}
+
+		template<std::input_iterator InputIt>
+		skip_list(InputIt first, InputIt last, const Compare& comp = Compare(), const Alloc& alloc = Alloc())
+		: skip_list(comp, alloc)
+		{
+			build(first, last);
+		}
+
+		template<std::input_iterator InputIt>
+		skip_list(sorted_unique_t, InputIt first, InputIt last, const Compare& comp = Compare(), const Alloc& alloc = Alloc())
+		: skip_list(comp, alloc)
+		{
+			build_sorted(first, last);
+		}
+
+		~skip_list()
+		{
+			delete_list();
+		}
+
+		skip_list(const skip_list& another) : compare(another.compare),
+			pool(std::allocator_traits<Alloc>::select_on_container_copy_construction(another.pool.get_allocator())),
+			list_size(another.list_size), list_lvl(another.list_lvl)
+		{
+			if (!another.empty())
+			{
+				init_head_and_tail(another.head->get_level());
+				insert_sorted_nodes(another.head, another.tail);
+			}
+			else if constexpr (Shared_readers)
+			{
+				init_head_and_tail();
+			}
+		}
+
+		skip_list(skip_list&& another) noexcept : head(another.head), tail(another.tail),compare(std::move_if_noexcept(another.compare)),
+			pool(std::move(another.pool)),list_size(another.list_size), list_lvl(another.list_lvl),
+			growth_size(another.growth_size), finger(std::move(another.finger)), finger_ranks(std::move(another.finger_ranks)),
+			readers(std::move(another.readers))
+		{
+			another.list_lvl = 0;
+			another.list_size = 0;
+			another.head = nullptr;
+			another.tail = nullptr;
+		}
+
+		skip_list& operator=(const skip_list& another)
+		{
+			if (this == &another)
+			{
+				return *this;
+			}
+			delete_list();
+			compare = another.compare;
+			if constexpr (propagate_on_copy)
+			{
+				if (pool.get_allocator() != another.pool.get_allocator())
+				{
+					pool = node_pool<list_node, Alloc, Max_level>(another.pool.get_allocator());
+				}
+			}
+			list_lvl = another.list_lvl;
+			list_size = another.list_size;
+			if (!another.empty())
+			{
+				init_head_and_tail(another.head->get_level());
+				insert_sorted_nodes(another.head, another.tail);
+			}
+			return *this;
+		}
+
+		skip_list& operator=(skip_list&& another) noexcept(propagate_on_move || allocators_always_equal)
+		{
+			if (this == &another)
+			{
+				return *this;
+			}
+			compare = std::move_if_noexcept(another.compare);
+			if constexpr (!propagate_on_move && !allocators_always_equal)
+			{
+				if (pool.get_allocator() != another.pool.get_allocator())
+				{
+					move_nodes_from(another);
+					return *this;
+				}
+			}
+			pool.template swap<propagate_on_move>(another.pool);
+			std::swap(list_size, another.list_size);
+			std::swap(list_lvl, another.list_lvl);
+			std::swap(growth_size, another.growth_size);
+			std::swap(finger, another.finger);
+			std::swap(finger_ranks, another.finger_ranks);
+			std::swap(readers, another.readers);
+			std::swap(head, another.head);
+			std::swap(tail, another.tail);
+			return *this;
+		}
+
+		template<std::input_iterator InputIt>
+		void assign(InputIt first, InputIt last)
+		{
+			build(first, last);
+		}
+
+		template<std::input_iterator InputIt>
+		void assign(sorted_unique_t, InputIt first, InputIt last)
+		{
+			build_sorted(first, last);
+		}
+
+		void assign(const std::initializer_list<value_type>& list)
+		{
+			build(list.begin(), list.end());
+		}
+
+		void save(std::ostream& out) const requires serializable<Key> && serializable<Value>
+		{
+			stream_writer writer(out);
+			save_to(writer);
+		}
+
+		void save(std::vector<std::byte>& buffer) const requires serializable<Key> && serializable<Value>
+		{
+			buffer_writer writer(buffer);
+			save_to(writer);
+		}
+
+		void load(std::istream& in) requires serializable<Key> && serializable<Value>
+		{
+			stream_reader reader(in);
+			load_from(reader);
+		}
+
+		size_type load(const std::span<const std::byte> buffer) requires serializable<Key> && serializable<Value>
+		{
+			buffer_reader reader(buffer);
+			load_from(reader);
+			return reader.consumed();
+		}
+
+		iterator begin()
+		{
+			if(head == nullptr){return end();}
+			return iterator(tail, head->next());
+		}
+
+		iterator end() { return iterator(tail, tail); }
+
+		[[nodiscard]] const_iterator cbegin() const
+		{
+			if (head == nullptr){return cend();}
+			return const_iterator(tail, head->next());
+		}
+
+		[[nodiscard]] const_iterator cend() const { return const_iterator(tail, tail); }
+		[[nodiscard]] const_iterator begin() const { return cbegin(); }
+		[[nodiscard]] const_iterator end() const { return cend(); }
+
+		[[nodiscard]] bool empty() const
+		{
+			return list_size == static_cast<size_t>(0);
+		}
+
+		[[nodiscard]] size_t size() const { return list_size; }
+
+		[[nodiscard]] Alloc get_allocator() const { return pool.get_allocator(); }
+
+		void shrink_to_fit() noexcept
+		{
+			pool.release();
+		}
+
+		[[nodiscard]] skip_list_statistics<Max_level> statistics() const requires Statistics
+		{
+			using pool_type = node_pool<list_node, Alloc, Max_level>;
+			skip_list_statistics<Max_level> result;
+			counters.fill(result);
+			result.list_level = list_lvl.get_size();
+			result.bytes_allocated = pool.cached_bytes();
+			if (head == nullptr)
+			{
+				return result;
+			}
+			result.head_level = head->get_level().get_size();
+			result.bytes_allocated += pool_type::block_bytes(result.head_level) + pool_type::block_bytes(tail->get_level().get_size());
+			for (auto node = head->next(); node != tail; node = node->next())
+			{
+				const size_t lvl = node->get_level().get_size();
+				++result.level_histogram[lvl - 1];
+				result.bytes_allocated += pool_type::block_bytes(lvl);
+			}
+			if constexpr (Shared_readers)
+			{
+				for (const auto& retired_node : readers.retired)
+				{
+					result.bytes_allocated += pool_type::block_bytes(retired_node.first->get_level().get_size());
+				}
+			}
+			return result;
+		}
+
+		void reset_statistics() noexcept requires Statistics
+		{
+			counters.reset();
+		}
+
+		[[nodiscard]] epoch_domain::guard read_lock() const requires Shared_readers
+		{
+			if (readers.domain == nullptr)
+			{
+				return {};
+			}
+			return readers.domain->pin();
+		}
+
+		void reclaim_retired() noexcept requires Shared_readers
+		{
+			reclaim_retired_nodes();
+		}
+
+		[[nodiscard]] uint64_t current_epoch() const noexcept requires Shared_readers
+		{
+			return readers.domain == nullptr ? 0 : readers.domain->current_epoch();
+		}
+
+		Value& operator[](const Key& key)
+			requires std::is_default_constructible_v<Value>
+		{
+			auto searched_key = lookup_node(key);
+			if (searched_key == tail)
+			{
+				Value new_value{};
+				auto new_node = insert(std::make_pair(key, new_value));
+				return (*new_node.first).second;
+			}
+			return searched_key->get_value();
+		}
+
+		[[nodiscard]] const Value& at(const Key& key) const
+		{
+			list_node* searched_key = search_key(key);
+			if (searched_key == tail)
+			{
+				throw std::out_of_range("Out of range!");
+			}
+			auto& value = searched_key->get_value();
+			return value;
+		}
+
+		Value& at(const Key& key)
+		{
+			return const_cast<Value&>(const_cast<const skip_list*>(this)->at(key));
+		}
+
+		template<class Pair>
+			requires std::is_convertible_v<std::pair<Key, Value>, std::remove_cvref_t<Pair>>
+		std::pair<iterator, bool> insert(Pair&& value_nods)
+		{
+			if (head == nullptr && tail == nullptr)
+			{
+				init_head_and_tail();
+			}
+			Level<Max_level> level = random_level();
+			const auto& updated_nods = search_key_storing_past_elements(value_nods.first);
+			auto found_element = updated_nods[0]->next();
+			if (found_element != tail)
+			{
+				if (equal_key<Key>(found_element->get_key(), value_nods.first))
+				{
+					return std::pair<iterator, bool>(iterator(tail, found_element), false);
+				}
+			}
+			auto new_node = list_node::create(pool, std::forward<Pair>(value_nods), level);
+			for (Level<Max_level> index = 0; index < level; ++index)
+			{
+				new_node->link_with_left_node(updated_nods[index], index);
+			}
+			if constexpr (Indexable)
+			{
+				update_widths_after_insert(updated_nods, finger_ranks, new_node);
+			}
+			advance_finger(new_node);
+			if (level > list_lvl){list_lvl = level;}
+			counters.count_insert();
+			if (++list_size >= growth_size)
+			{
+				grow_head();
+			}
+			return std::pair<iterator, bool>(iterator(tail, new_node), true);
+		}
+
+		template<std::input_iterator InputIt>
+		size_type insert_sorted(InputIt first, InputIt last)
+		{
+			const size_type old_size = list_size;
+			if (empty())
+			{
+				build(first, last);
+				return list_size;
+			}
+			for (; first != last; ++first)
+			{
+				insert(*first);
+			}
+			return list_size - old_size;
+		}
+
+		void erase(iterator position)
+		{
+			if (position.get_node_value() == tail)
+			{
+				return;
+			}
+			delete_node(position.get_node_value());
+		}
+
+		size_type erase(const Key& key)
+		{
+			auto del_element = search_key_from_finger(key);
+			if (del_element != tail)
+			{
+				delete_node(del_element);
+			}
+			return list_size;
+		}
+
+		void erase(iterator first, iterator last)
+		{
+			auto first_node = first.get_node_value();
+			auto last_node = last.get_node_value();
+			if (first_node == last_node || first_node == tail)
+			{
+				return;
+			}
+			const auto& updated_nods = search_key_storing_past_elements(first_node->get_key());
+			size_t removed = 0;
+			for (size_t lvl_index = 0; lvl_index < list_lvl.get_size(); ++lvl_index)
+			{
+				auto right_node = updated_nods[lvl_index]->get_right_node(lvl_index);
+				size_t width = 0;
+				if constexpr (Indexable)
+				{
+					width = updated_nods[lvl_index]->get_width(lvl_index);
+				}
+				while (right_node != tail && right_node != last_node &&
+					(last_node == tail || compare(right_node->get_key(), last_node->get_key())))
+				{
+					if constexpr (Indexable)
+					{
+						width += right_node->get_width(lvl_index);
+						removed += lvl_index == 0 ? 1 : 0;
+					}
+					right_node = right_node->get_right_node(lvl_index);
+				}
+				updated_nods[lvl_index]->set_right_node(lvl_index, right_node);
+				if constexpr (Indexable)
+				{
+					updated_nods[lvl_index]->set_width(lvl_index, width - removed);
+				}
+			}
+			if constexpr (Indexable)
+			{
+				for (size_t index = list_lvl; index < head->get_level(); ++index)
+				{
+					head->set_width(index, head->get_width(index) - removed);
+				}
+			}
+			last_node->set_left_node(updated_nods[0]);
+			const size_t released = release_nodes(first_node, last_node);
+			counters.count_erase(released);
+			list_size -= released;
+			shrink_list_lvl();
+		}
+
+		void swap(skip_list& another) noexcept(propagate_on_swap || allocators_always_equal)
+		{
+			if(this == &another)
+			{
+				return;
+			}
+			if constexpr (!propagate_on_swap && !allocators_always_equal)
+			{
+				if (pool.get_allocator() != another.pool.get_allocator())
+				{
+					skip_list to_another(compare, another.pool.get_allocator());
+					to_another.move_nodes_from(*this);
+					skip_list to_this(another.compare, pool.get_allocator());
+					to_this.move_nodes_from(another);
+					swap(to_this);
+					another.swap(to_another);
+					return;
+				}
+			}
+			std::swap(list_lvl, another.list_lvl);
+			std::swap(list_size, another.list_size);
+			std::swap(growth_size, another.growth_size);
+			std::swap(finger, another.finger);
+			std::swap(finger_ranks, another.finger_ranks);
+			std::swap(readers, another.readers);
+			pool.swap(another.pool);
+			std::swap(compare, another.compare);
+			std::swap(head, another.head);
+			std::swap(tail, another.tail);
+		}
+
+		void clear()
+		{
+			if (head == nullptr)
+			{
+				return;
+			}
+			auto first_node = head->get_right_node(0);
+			list_node::bind_node(head, tail);
+			release_nodes(first_node, tail);
+			list_size = 0;
+			list_lvl = 0;
+			reset_finger();
+		}
+
+		[[nodiscard]] const_iterator find(const Key& key) const
+		{
+			counters.count_find();
+			auto searched_node = search_key(key);
+			if (searched_node == tail)
+			{
+				return const_iterator(tail, tail);
+			}
+			if (equal_key(searched_node->get_key(), key))
+			{
+				return const_iterator(tail, searched_node);
+			}
+			return const_iterator(tail, tail);
+		}
+
+		iterator find(const Key& key)
+		{
+			counters.count_find();
+			auto searched_node = lookup_node(key);
+			if (searched_node == tail)
+			{
+				return iterator(tail, tail);
+			}
+			if (equal_key(searched_node->get_key(), key))
+			{
+				return iterator(tail, searched_node);
+			}
+			return iterator(tail, tail);
+		}
+
+		template <std::forward_iterator Key_iterator, std::output_iterator<const_iterator> Out>
+			requires std::convertible_to<std::iter_reference_t<Key_iterator>, const Key&>
+		Out find_many(Key_iterator first, Key_iterator last, Out out) const
+		{
+			if constexpr (Statistics)
+			{
+				counters.count_find(static_cast<size_t>(std::distance(first, last)));
+			}
+			search_keys_interleaved(first, last, [&](list_node* found_node) { *out++ = const_iterator(tail, found_node); });
+			return out;
+		}
+
+		template <std::forward_iterator Key_iterator, std::output_iterator<iterator> Out>
+			requires std::convertible_to<std::iter_reference_t<Key_iterator>, const Key&>
+		Out find_many(Key_iterator first, Key_iterator last, Out out)
+		{
+			if constexpr (Statistics)
+			{
+				counters.count_find(static_cast<size_t>(std::distance(first, last)));
+			}
+			search_keys_interleaved(first, last, [&](list_node* found_node) { *out++ = iterator(tail, found_node); });
+			return out;
+		}
+
+		reverse_iterator rbegin() { return reverse_iterator(iterator(tail, tail)); }
+		reverse_iterator rend() { return reverse_iterator(iterator(tail, head->next())); }
+		[[nodiscard]] const_reverse_iterator rbegin() const { return const_reverse_iterator(const_iterator(tail, tail)); }
+		[[nodiscard]] const_reverse_iterator rend() const { return const_reverse_iterator(const_iterator(tail, head->next())); }
+
+		[[nodiscard]] size_type count(const Key& key) const
+		{
+			auto searched_node = search_key(key);
+			if (searched_node == tail)
+			{
+				return 0;
+			}
+			return 1;
+		}
+
+		[[nodiscard]] const_iterator lower_bound(const Key& key) const { return const_iterator(tail, search_lower_bound(key)); }
+		iterator lower_bound(const Key& key) { return iterator(tail, search_lower_bound(key)); }
+		[[nodiscard]] const_iterator upper_bound(const Key& key) const { return const_iterator(tail, search_upper_bound(key)); }
+		iterator upper_bound(const Key& key) { return iterator(tail, search_upper_bound(key)); }
+
+		[[nodiscard]] std::pair<const_iterator, const_iterator> equal_range(const Key& key) const
+		{
+			auto lower_node = search_lower_bound(key);
+			auto upper_node = lower_node != tail && !compare(key, lower_node->get_key()) ? lower_node->get_right_node(0) : lower_node;
+			return std::pair<const_iterator, const_iterator>(const_iterator(tail, lower_node), const_iterator(tail, upper_node));
+		}
+
+		std::pair<iterator, iterator> equal_range(const Key& key)
+		{
+			auto [lower, upper] = static_cast<const skip_list*>(this)->equal_range(key);
+			return std::pair<iterator, iterator>(iterator(tail, lower.get_node_value()), iterator(tail, upper.get_node_value()));
+		}
+
+		[[nodiscard]] range_view<true> range(const Key& lower_key, const Key& upper_key) const
+		{
+			return range_view<true>(lower_bound(lower_key), &compare, upper_key, tail);
+		}
+
+		range_view<false> range(const Key& lower_key, const Key& upper_key)
+		{
+			return range_view<false>(lower_bound(lower_key), &compare, upper_key, tail);
+		}
+
+		[[nodiscard]] const_iterator nth(const size_type index) const requires Indexable
+		{
+			return const_iterator(tail, search_index(index));
+		}
+
+		iterator nth(const size_type index) requires Indexable
+		{
+			return iterator(tail, search_index(index));
+		}
+
+		[[nodiscard]] size_type rank(const Key& key) const requires Indexable
+		{
+			if (head == nullptr)
+			{
+				return 0;
+			}
+			auto node = head;
+			size_t rank = 0;
+			auto probe = counters.start_search();
+			for (int lvl_index = static_cast<int>(search_lvl()) - 1; lvl_index >= 0; --lvl_index)
+			{
+				node = next_less_key_element(node, lvl_index, key, rank, probe);
+			}
+			return rank;
+		}
+
+		template <size_t Other_Max_level, typename Other_generator, bool Other_indexable, bool Other_shared, bool Other_statistics>
+			requires comparable_value<Value>
+		bool operator==(const skip_list<Key, Value, Compare, Other_Max_level, Alloc, Other_generator, Other_indexable, Other_shared, Other_statistics>& another) const
+		{
+			if (another.size() != list_size || empty() || another.empty())
+			{
+				return false;
+			}
+			auto another_node = another.cbegin();
+			auto node = cbegin();
+			for (size_t index = 0; index != list_size; ++index)
+			{
+				if (!equal_key((*node).first, (*another_node).first) ||
+					(*node).second != (*another_node).second)
+				{
+					return false;
+				}
+				++node;
+				++another_node;
+			}
+			return true;
+		}
+
+		template <size_t Other_Max_level, typename Other_generator, bool Other_indexable, bool Other_shared, bool Other_statistics>
+			requires comparable_value<Value>
+		bool operator!=(const skip_list<Key, Value, Compare, Other_Max_level, Alloc, Other_generator, Other_indexable, Other_shared, Other_statistics>& another) const
 		{
 			return !(*this == another);
 		}
 	};
-}
\ No newline at end of file
+
+	namespace pmr
+	{
+		template <valid_Key Key,
+			valid_Value Value,
+			typename Compare = std::less<Key>,
+			size_t Max_level = default_max_level,
+			level_generator_policy Level_generator = random_tools::level_generator<>>
+		using skip_list = skip_list_space::skip_list<Key, Value, Compare, Max_level,
+			std::pmr::polymorphic_allocator<std::pair<const Key, Value>>, Level_generator>;
+	}
+
+	template <valid_Key Key,
+		valid_Value Value,
+		typename Compare = std::less<Key>,
+		size_t Max_level = default_max_level,
+		typename Alloc = std::allocator<std::pair<const Key, Value>>,
+		level_generator_policy Level_generator = random_tools::level_generator<>>
+	using indexable_skip_list = skip_list<Key, Value, Compare, Max_level, Alloc, Level_generator, true>;
+
+	template <valid_Key Key,
+		valid_Value Value,
+		typename Compare = std::less<Key>,
+		size_t Max_level = default_max_level,
+		typename Alloc = std::allocator<std::pair<const Key, Value>>,
+		level_generator_policy Level_generator = random_tools::level_generator<>>
+	using single_writer_skip_list = skip_list<Key, Value, Compare, Max_level, Alloc, Level_generator, false, true>;
+
+	template <valid_Key Key,
+		valid_Value Value,
+		typename Compare = std::less<Key>,
+		size_t Max_level = default_max_level,
+		typename Alloc = std::allocator<std::pair<const Key, Value>>,
+		level_generator_policy Level_generator = random_tools::level_generator<>>
+	using instrumented_skip_list = skip_list<Key, Value, Compare, Max_level, Alloc, Level_generator, false, false, true>;
+
+	template <level_generator_policy Level_generator>
+	[[nodiscard]] Level_generator make_thread_level_generator()
+	{
+		if constexpr (std::constructible_from<Level_generator, uint64_t>)
+		{
+			static std::atomic<uint64_t> thread_seeds{ 0 };
+			random_tools::splitmix64 seeds(thread_seeds.fetch_add(1, std::memory_order_relaxed));
+			return Level_generator(seeds());
+		}
+		else
+		{
+			return Level_generator{};
+		}
+	}
+
+	template <level_generator_policy Level_generator>
+	[[nodiscard]] size_t thread_random_level(const size_t max_lvl)
+	{
+		thread_local Level_generator level_generator = make_thread_level_generator<Level_generator>();
+		return std::clamp<size_t>(level_generator(max_lvl), 1, max_lvl);
+	}
+
+	template <typename Key, typename Value, size_t Max_level>
+	class concurrent_node final : public retired_object
+	{
+		using value_type = std::pair<const Key, Value>;
+		using link_type = std::atomic<uintptr_t>;
+
+		static constexpr uintptr_t mark_bit = 1;
+
+		size_t level;
+		std::atomic<int> owners{ 2 };
+		bool valid = false;
+		alignas(value_type) unsigned char node_value[sizeof(value_type)]{};
+
+		explicit concurrent_node(const size_t level_) noexcept : level(level_) {}
+
+		[[nodiscard]] link_type* links() noexcept
+		{
+			return reinterpret_cast<link_type*>(reinterpret_cast<unsigned char*>(this) + sizeof(concurrent_node));
+		}
+
+		[[nodiscard]] value_type* value_pointer() noexcept { return std::launder(reinterpret_cast<value_type*>(node_value)); }
+
+		template<typename Blocks>
+		static concurrent_node* allocate_node(Blocks& blocks, const size_t level_)
+		{
+			using block_traits = std::allocator_traits<Blocks>;
+			auto memory = std::to_address(block_traits::allocate(blocks, block_count<Blocks>(level_)));
+			auto new_node = ::new(static_cast<void*>(memory)) concurrent_node(level_);
+			for (size_t index = 0; index < level_; ++index)
+			{
+				::new(static_cast<void*>(new_node->links() + index)) link_type(0);
+			}
+			return new_node;
+		}
+
+		template<typename Blocks>
+		[[nodiscard]] static constexpr size_t block_count(const size_t level_) noexcept
+		{
+			using block = typename std::allocator_traits<Blocks>::value_type;
+			return (allocation_size(level_) + sizeof(block) - 1) / sizeof(block);
+		}
+
+	public:
+		concurrent_node(const concurrent_node&) = delete;
+		concurrent_node& operator=(const concurrent_node&) = delete;
+
+		[[nodiscard]] static constexpr size_t allocation_size(const size_t level_) noexcept
+		{
+			return sizeof(concurrent_node) + level_ * sizeof(link_type);
+		}
+
+		template<typename Blocks, typename Alloc, typename Pair>
+		static concurrent_node* create(Blocks& blocks, Alloc& alloc, Pair&& node_value_, const size_t level_)
+		{
+			auto new_node = allocate_node(blocks, level_);
+			try
+			{
+				std::allocator_traits<Alloc>::construct(alloc, new_node->value_pointer(), std::forward<Pair>(node_value_));
+			}
+			catch (...)
+			{
+				destroy(blocks, alloc, new_node);
+				throw;
+			}
+			new_node->valid = true;
+			return new_node;
+		}
+
+		template<typename Blocks>
+		static concurrent_node* create_sentinel(Blocks& blocks, const size_t level_)
+		{
+			return allocate_node(blocks, level_);
+		}
+
+		template<typename Blocks, typename Alloc>
+		static void destroy(Blocks& blocks, Alloc& alloc, concurrent_node* del_node) noexcept
+		{
+			using block_traits = std::allocator_traits<Blocks>;
+			using block = typename block_traits::value_type;
+			if (del_node->valid)
+			{
+				std::allocator_traits<Alloc>::destroy(alloc, del_node->value_pointer());
+			}
+			const size_t level_ = del_node->level;
+			del_node->~concurrent_node();
+			block_traits::deallocate(blocks, std::pointer_traits<typename block_traits::pointer>::pointer_to(
+				*std::launder(reinterpret_cast<block*>(del_node))), block_count<Blocks>(level_));
+		}
+
+		[[nodiscard]] static concurrent_node* pointer(const uintptr_t link) noexcept { return reinterpret_cast<concurrent_node*>(link & ~mark_bit); }
+		[[nodiscard]] static bool is_marked(const uintptr_t link) noexcept { return (link & mark_bit) != 0; }
+		[[nodiscard]] static uintptr_t marked(const uintptr_t link) noexcept { return link | mark_bit; }
+		[[nodiscard]] static uintptr_t address(const concurrent_node* target) noexcept { return reinterpret_cast<uintptr_t>(target); }
+
+		[[nodiscard]] link_type& link(const size_t index) noexcept { return links()[index]; }
+		[[nodiscard]] size_t get_level() const noexcept { return level; }
+		[[nodiscard]] const Key& get_key() noexcept { return value_pointer()->first; }
+		[[nodiscard]] const value_type& get_node_value() noexcept { return *value_pointer(); }
+
+		bool release_owner() noexcept
+		{
+			return owners.fetch_sub(1, std::memory_order_acq_rel) == 1;
+		}
+	};
+
+	template <valid_Key Key,
+		valid_Value Value,
+		typename Compare = std::less<Key>,
+		size_t Max_level = default_max_level,
+		typename Alloc = std::allocator<std::pair<const Key, Value>>,
+		level_generator_policy Level_generator = random_tools::level_generator<>>
+		requires is_compare<Compare, Key>
+	class concurrent_skip_list final
+	{
+		using list_node = concurrent_node<Key, Value, Max_level>;
+
+		struct alignas(list_node) node_block
+		{
+			unsigned char bytes[alignof(list_node)];
+		};
+
+		using block_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<node_block>;
+		using node_array = std::array<list_node*, Max_level>;
+
+		Compare compare;
+		Alloc allocator;
+		block_allocator blocks;
+		list_node* head = nullptr;
+		list_node* tail = nullptr;
+		std::atomic<size_t> list_size{ 0 };
+		std::atomic<size_t> list_lvl{ 1 };
+		mutable epoch_domain domain{ &reclaim_node, this };
+
+		static void reclaim_node(retired_object* object, void* list) noexcept
+		{
+			auto self = static_cast<concurrent_skip_list*>(list);
+			list_node::destroy(self->blocks, self->allocator, static_cast<list_node*>(object));
+		}
+
+		[[nodiscard]] bool equal_key(const Key& first, const Key& second) const
+		{
+			return !compare(first, second) && !compare(second, first);
+		}
+
+		void raise_list_lvl(const size_t lvl) noexcept
+		{
+			size_t current = list_lvl.load();
+			while (current < lvl && !list_lvl.compare_exchange_weak(current, lvl)) {}
+		}
+
+		bool try_search(const Key& key, node_array& preds, node_array& succs, const bool past_equal) const
+		{
+			auto pred = head;
+			for (size_t lvl_index = list_lvl.load(); lvl_index-- > 0;)
+			{
+				auto current = list_node::pointer(pred->link(lvl_index).load());
+				while (current != tail)
+				{
+					auto next = current->link(lvl_index).load();
+					if (list_node::is_marked(next))
+					{
+						auto expected = list_node::address(current);
+						if (!pred->link(lvl_index).compare_exchange_strong(expected, list_node::address(list_node::pointer(next))))
+						{
+							return false;
+						}
+						current = list_node::pointer(next);
+						continue;
+					}
+					if (!compare(current->get_key(), key) && (!past_equal || compare(key, current->get_key())))
+					{
+						break;
+					}
+					pred = current;
+					current = list_node::pointer(next);
+				}
+				preds[lvl_index] = pred;
+				succs[lvl_index] = current;
+			}
+			return true;
+		}
+
+		bool search(const Key& key, node_array& preds, node_array& succs, const bool past_equal = false) const
+		{
+			while (!try_search(key, preds, succs, past_equal)) {}
+			return succs[0] != tail && equal_key(succs[0]->get_key(), key);
+		}
+
+		void link_upper_levels(list_node* new_node, node_array& preds, node_array& succs)
+		{
+			const auto& key = new_node->get_key();
+			for (size_t lvl_index = 1; lvl_index < new_node->get_level(); ++lvl_index)
+			{
+				while (true)
+				{
+					auto current = new_node->link(lvl_index).load();
+					const auto successor = list_node::address(succs[lvl_index]);
+					if (list_node::is_marked(current))
+					{
+						return;
+					}
+					if (current != successor && !new_node->link(lvl_index).compare_exchange_strong(current, successor))
+					{
+						continue;
+					}
+					auto expected = successor;
+					if (preds[lvl_index]->link(lvl_index).compare_exchange_strong(expected, list_node::address(new_node)))
+					{
+						break;
+					}
+					search(key, preds, succs);
+					if (succs[0] != new_node)
+					{
+						return;
+					}
+				}
+			}
+		}
+
+		void release_node(epoch_domain::guard& guard, list_node* del_node)
+		{
+			if (del_node->release_owner())
+			{
+				guard.retire(del_node);
+			}
+		}
+
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using value_type = std::pair<const Key, Value>;
+		using size_type = std::size_t;
+		using key_compare = Compare;
+		using allocator_type = Alloc;
+
+		explicit concurrent_skip_list(const Compare& comp = Compare(), const Alloc& alloc = Alloc())
+			: compare(comp), allocator(alloc), blocks(alloc)
+		{
+			head = list_node::create_sentinel(blocks, Max_level);
+			try
+			{
+				tail = list_node::create_sentinel(blocks, Max_level);
+			}
+			catch (...)
+			{
+				list_node::destroy(blocks, allocator, head);
+				throw;
+			}
+			for (size_t lvl_index = 0; lvl_index < Max_level; ++lvl_index)
+			{
+				head->link(lvl_index).store(list_node::address(tail), std::memory_order_relaxed);
+			}
+		}
+
+		explicit concurrent_skip_list(const Alloc& alloc) : concurrent_skip_list(Compare(), alloc) {}
+
+		concurrent_skip_list(const concurrent_skip_list&) = delete;
+		concurrent_skip_list& operator=(const concurrent_skip_list&) = delete;
+
+		~concurrent_skip_list()
+		{
+			domain.reclaim_all();
+			auto current = head;
+			while (current != tail)
+			{
+				auto next = list_node::pointer(current->link(0).load(std::memory_order_relaxed));
+				list_node::destroy(blocks, allocator, current);
+				current = next;
+			}
+			list_node::destroy(blocks, allocator, tail);
+		}
+
+		template<typename Pair>
+			requires std::is_convertible_v<std::pair< Key, Value>, std::remove_cvref_t<Pair>>
+		bool insert(Pair&& value_nods)
+		{
+			const size_t new_lvl = thread_random_level<Level_generator>(Max_level);
+			raise_list_lvl(new_lvl);
+			auto guard = domain.pin();
+			node_array preds{};
+			node_array succs{};
+			list_node* new_node = nullptr;
+			const Key* key = &value_nods.first;
+			while (true)
+			{
+				if (search(*key, preds, succs))
+				{
+					if (new_node != nullptr)
+					{
+						list_node::destroy(blocks, allocator, new_node);
+					}
+					return false;
+				}
+				if (new_node == nullptr)
+				{
+					new_node = list_node::create(blocks, allocator, std::forward<Pair>(value_nods), new_lvl);
+					key = &new_node->get_key();
+				}
+				for (size_t lvl_index = 0; lvl_index < new_lvl; ++lvl_index)
+				{
+					new_node->link(lvl_index).store(list_node::address(succs[lvl_index]), std::memory_order_relaxed);
+				}
+				auto expected = list_node::address(succs[0]);
+				if (preds[0]->link(0).compare_exchange_strong(expected, list_node::address(new_node)))
+				{
+					break;
+				}
+			}
+			list_size.fetch_add(1, std::memory_order_relaxed);
+			link_upper_levels(new_node, preds, succs);
+			if (list_node::is_marked(new_node->link(0).load()))
+			{
+				search(new_node->get_key(), preds, succs, true);
+			}
+			release_node(guard, new_node);
+			return true;
+		}
+
+		bool erase(const Key& key)
+		{
+			auto guard = domain.pin();
+			node_array preds{};
+			node_array succs{};
+			if (!search(key, preds, succs))
+			{
+				return false;
+			}
+			auto victim = succs[0];
+			for (size_t lvl_index = victim->get_level() - 1; lvl_index > 0; --lvl_index)
+			{
+				auto next = victim->link(lvl_index).load();
+				while (!list_node::is_marked(next) && !victim->link(lvl_index).compare_exchange_weak(next, list_node::marked(next))) {}
+			}
+			auto next = victim->link(0).load();
+			while (true)
+			{
+				if (list_node::is_marked(next))
+				{
+					return false;
+				}
+				if (victim->link(0).compare_exchange_strong(next, list_node::marked(next)))
+				{
+					break;
+				}
+			}
+			list_size.fetch_sub(1, std::memory_order_relaxed);
+			search(key, preds, succs, true);
+			release_node(guard, victim);
+			return true;
+		}
+
+		[[nodiscard]] std::optional<Value> find(const Key& key) const
+		{
+			auto guard = domain.pin();
+			auto pred = head;
+			list_node* current = tail;
+			for (size_t lvl_index = list_lvl.load(std::memory_order_acquire); lvl_index-- > 0;)
+			{
+				current = list_node::pointer(pred->link(lvl_index).load(std::memory_order_acquire));
+				while (current != tail)
+				{
+					const auto next = current->link(lvl_index).load(std::memory_order_acquire);
+					if (!list_node::is_marked(next))
+					{
+						if (!compare(current->get_key(), key))
+						{
+							break;
+						}
+						pred = current;
+					}
+					current = list_node::pointer(next);
+				}
+			}
+			if (current != tail && equal_key(current->get_key(), key) && !list_node::is_marked(current->link(0).load(std::memory_order_acquire)))
+			{
+				return current->get_node_value().second;
+			}
+			return std::nullopt;
+		}
+
+		[[nodiscard]] bool contains(const Key& key) const
+		{
+			return find(key).has_value();
+		}
+
+		template<typename Function>
+		void for_each(Function&& function) const
+		{
+			auto guard = domain.pin();
+			auto current = list_node::pointer(head->link(0).load(std::memory_order_acquire));
+			while (current != tail)
+			{
+				const auto next = current->link(0).load(std::memory_order_acquire);
+				if (!list_node::is_marked(next))
+				{
+					function(current->get_node_value());
+				}
+				current = list_node::pointer(next);
+			}
+		}
+
+		[[nodiscard]] size_type size() const noexcept { return list_size.load(std::memory_order_relaxed); }
+		[[nodiscard]] bool empty() const noexcept { return size() == 0; }
+		[[nodiscard]] Alloc get_allocator() const { return allocator; }
+	};
+
+	template <typename Key, typename Value, size_t Max_level>
+	class lazy_node final : public retired_object
+	{
+		using value_type = std::pair<const Key, Value>;
+		using link_type = std::atomic<lazy_node*>;
+
+		size_t level;
+		std::atomic<bool> locked{ false };
+		std::atomic<bool> marked{ false };
+		std::atomic<bool> fully_linked{ false };
+		bool valid = false;
+		alignas(value_type) unsigned char node_value[sizeof(value_type)]{};
+
+		explicit lazy_node(const size_t level_) noexcept : level(level_) {}
+
+		[[nodiscard]] link_type* links() noexcept
+		{
+			return reinterpret_cast<link_type*>(reinterpret_cast<unsigned char*>(this) + sizeof(lazy_node));
+		}
+
+		[[nodiscard]] value_type* value_pointer() noexcept { return std::launder(reinterpret_cast<value_type*>(node_value)); }
+
+		template<typename Blocks>
+		[[nodiscard]] static constexpr size_t block_count(const size_t level_) noexcept
+		{
+			using block = typename std::allocator_traits<Blocks>::value_type;
+			return (allocation_size(level_) + sizeof(block) - 1) / sizeof(block);
+		}
+
+		template<typename Blocks>
+		static lazy_node* allocate_node(Blocks& blocks, const size_t level_)
+		{
+			using block_traits = std::allocator_traits<Blocks>;
+			auto memory = std::to_address(block_traits::allocate(blocks, block_count<Blocks>(level_)));
+			auto new_node = ::new(static_cast<void*>(memory)) lazy_node(level_);
+			for (size_t index = 0; index < level_; ++index)
+			{
+				::new(static_cast<void*>(new_node->links() + index)) link_type(nullptr);
+			}
+			return new_node;
+		}
+
+	public:
+		lazy_node(const lazy_node&) = delete;
+		lazy_node& operator=(const lazy_node&) = delete;
+
+		[[nodiscard]] static constexpr size_t allocation_size(const size_t level_) noexcept
+		{
+			return sizeof(lazy_node) + level_ * sizeof(link_type);
+		}
+
+		template<typename Blocks, typename Alloc, typename Pair>
+		static lazy_node* create(Blocks& blocks, Alloc& alloc, Pair&& node_value_, const size_t level_)
+		{
+			auto new_node = allocate_node(blocks, level_);
+			try
+			{
+				std::allocator_traits<Alloc>::construct(alloc, new_node->value_pointer(), std::forward<Pair>(node_value_));
+			}
+			catch (...)
+			{
+				destroy(blocks, alloc, new_node);
+				throw;
+			}
+			new_node->valid = true;
+			return new_node;
+		}
+
+		template<typename Blocks>
+		static lazy_node* create_sentinel(Blocks& blocks, const size_t level_)
+		{
+			auto sentinel = allocate_node(blocks, level_);
+			sentinel->fully_linked.store(true, std::memory_order_relaxed);
+			return sentinel;
+		}
+
+		template<typename Blocks, typename Alloc>
+		static void destroy(Blocks& blocks, Alloc& alloc, lazy_node* del_node) noexcept
+		{
+			using block_traits = std::allocator_traits<Blocks>;
+			using block = typename block_traits::value_type;
+			if (del_node->valid)
+			{
+				std::allocator_traits<Alloc>::destroy(alloc, del_node->value_pointer());
+			}
+			const size_t level_ = del_node->level;
+			del_node->~lazy_node();
+			block_traits::deallocate(blocks, std::pointer_traits<typename block_traits::pointer>::pointer_to(
+				*std::launder(reinterpret_cast<block*>(del_node))), block_count<Blocks>(level_));
+		}
+
+		void lock() noexcept
+		{
+			while (locked.exchange(true, std::memory_order_acquire))
+			{
+				while (locked.load(std::memory_order_relaxed))
+				{
+					std::this_thread::yield();
+				}
+			}
+		}
+
+		void unlock() noexcept
+		{
+			locked.store(false, std::memory_order_release);
+		}
+
+		[[nodiscard]] lazy_node* get_right_node(const size_t index) noexcept { return links()[index].load(std::memory_order_acquire); }
+		void set_right_node(const size_t index, lazy_node* value_) noexcept { links()[index].store(value_, std::memory_order_release); }
+
+		[[nodiscard]] bool is_marked() const noexcept { return marked.load(std::memory_order_acquire); }
+		void mark() noexcept { marked.store(true, std::memory_order_release); }
+		[[nodiscard]] bool is_fully_linked() const noexcept { return fully_linked.load(std::memory_order_acquire); }
+		void set_fully_linked() noexcept { fully_linked.store(true, std::memory_order_release); }
+		[[nodiscard]] bool is_live() const noexcept { return is_fully_linked() && !is_marked(); }
+
+		[[nodiscard]] size_t get_level() const noexcept { return level; }
+		[[nodiscard]] const Key& get_key() noexcept { return value_pointer()->first; }
+		[[nodiscard]] value_type& get_node_value() noexcept { return *value_pointer(); }
+	};
+
+	// Keeps the creating thread pinned, delaying reclamation for every thread while it lives.
+	// Copies pin the copying thread; an iterator must be destroyed on the thread that created or copied it.
+	template <bool IsConst, typename Key, typename Value, size_t Max_level>
+	class lazy_iterator final
+	{
+		using list_node = lazy_node<Key, Value, Max_level>;
+
+		epoch_domain::guard guard;
+		list_node* list_end = nullptr;
+		list_node* node_pointer = nullptr;
+
+		friend lazy_iterator<!IsConst, Key, Value, Max_level>;
+	public:
+		using value_type = std::pair<const Key, Value>;
+		using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+		using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+		using difference_type = std::ptrdiff_t;
+		using iterator_category = std::forward_iterator_tag;
+
+		lazy_iterator() = default;
+
+		lazy_iterator(epoch_domain::guard guard_, list_node* end_, list_node* node_ptr)
+			: guard(std::move(guard_)), list_end(end_), node_pointer(node_ptr) {}
+
+		template<bool Other_Const>
+			requires (!Other_Const || IsConst)
+		lazy_iterator(const lazy_iterator<Other_Const, Key, Value, Max_level>& other)
+			: guard(other.guard), list_end(other.list_end), node_pointer(other.node_pointer) {}
+
+		reference operator*() const
+		{
+			if (node_pointer == list_end)
+			{
+				throw error_dereferencing_end();
+			}
+			return node_pointer->get_node_value();
+		}
+
+		pointer operator->() const
+		{
+			return &**this;
+		}
+
+		lazy_iterator& operator++()
+		{
+			if (node_pointer == list_end)
+			{
+				throw std::out_of_range("out of range");
+			}
+			do
+			{
+				node_pointer = node_pointer->get_right_node(0);
+			} while (node_pointer != list_end && !node_pointer->is_live());
+			return *this;
+		}
+
+		lazy_iterator operator++(int)
+		{
+			auto previous = *this;
+			++*this;
+			return previous;
+		}
+
+		bool operator==(const lazy_iterator& other) const noexcept
+		{
+			return node_pointer == other.node_pointer;
+		}
+
+		bool operator!=(const lazy_iterator& other) const noexcept
+		{
+			return node_pointer != other.node_pointer;
+		}
+	};
+
+	template <valid_Key Key,
+		valid_Value Value,
+		typename Compare = std::less<Key>,
+		size_t Max_level = default_max_level,
+		typename Alloc = std::allocator<std::pair<const Key, Value>>,
+		level_generator_policy Level_generator = random_tools::level_generator<>>
+		requires is_compare<Compare, Key>
+	class lazy_skip_list final
+	{
+		using list_node = lazy_node<Key, Value, Max_level>;
+
+		struct alignas(list_node) node_block
+		{
+			unsigned char bytes[alignof(list_node)];
+		};
+
+		using block_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<node_block>;
+		using node_array = std::array<list_node*, Max_level>;
+
+		Compare compare;
+		Alloc allocator;
+		block_allocator blocks;
+		list_node* head = nullptr;
+		list_node* tail = nullptr;
+		std::atomic<size_t> list_size{ 0 };
+		std::atomic<size_t> list_lvl{ 1 };
+		mutable epoch_domain domain{ &reclaim_node, this };
+
+		static void reclaim_node(retired_object* object, void* list) noexcept
+		{
+			auto self = static_cast<lazy_skip_list*>(list);
+			list_node::destroy(self->blocks, self->allocator, static_cast<list_node*>(object));
+		}
+
+		[[nodiscard]] bool equal_key(const Key& first, const Key& second) const
+		{
+			return !compare(first, second) && !compare(second, first);
+		}
+
+		void raise_list_lvl(const size_t lvl) noexcept
+		{
+			size_t current = list_lvl.load();
+			while (current < lvl && !list_lvl.compare_exchange_weak(current, lvl)) {}
+		}
+
+		int search(const Key& key, node_array& preds, node_array& succs) const
+		{
+			int found_lvl = -1;
+			auto pred = head;
+			for (int lvl_index = static_cast<int>(list_lvl.load()) - 1; lvl_index >= 0; --lvl_index)
+			{
+				auto current = pred->get_right_node(lvl_index);
+				while (current != tail && compare(current->get_key(), key))
+				{
+					pred = current;
+					current = pred->get_right_node(lvl_index);
+				}
+				if (found_lvl == -1 && current != tail && equal_key(current->get_key(), key))
+				{
+					found_lvl = lvl_index;
+				}
+				preds[lvl_index] = pred;
+				succs[lvl_index] = current;
+			}
+			return found_lvl;
+		}
+
+		[[nodiscard]] list_node* search_live(const Key& key) const
+		{
+			auto pred = head;
+			for (int lvl_index = static_cast<int>(list_lvl.load(std::memory_order_acquire)) - 1; lvl_index >= 0; --lvl_index)
+			{
+				auto current = pred->get_right_node(lvl_index);
+				while (current != tail && compare(current->get_key(), key))
+				{
+					pred = current;
+					current = pred->get_right_node(lvl_index);
+				}
+				if (current != tail && equal_key(current->get_key(), key))
+				{
+					return current->is_live() ? current : tail;
+				}
+			}
+			return tail;
+		}
+
+		static void unlock_preds(const node_array& preds, const size_t locked_lvl) noexcept
+		{
+			list_node* previous = nullptr;
+			for (size_t lvl_index = 0; lvl_index < locked_lvl; ++lvl_index)
+			{
+				if (preds[lvl_index] != previous)
+				{
+					previous = preds[lvl_index];
+					previous->unlock();
+				}
+			}
+		}
+
+		template<typename Validate>
+		static bool lock_preds(const node_array& preds, const size_t lvl, size_t& locked_lvl, Validate&& validate) noexcept
+		{
+			list_node* previous = nullptr;
+			bool valid = true;
+			for (size_t lvl_index = 0; valid && lvl_index < lvl; ++lvl_index)
+			{
+				if (preds[lvl_index] != previous)
+				{
+					previous = preds[lvl_index];
+					previous->lock();
+				}
+				locked_lvl = lvl_index + 1;
+				valid = !preds[lvl_index]->is_marked() && validate(lvl_index);
+			}
+			return valid;
+		}
+
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using value_type = std::pair<const Key, Value>;
+		using size_type = std::size_t;
+		using key_compare = Compare;
+		using allocator_type = Alloc;
+		using iterator = lazy_iterator<false, Key, Value, Max_level>;
+		using const_iterator = lazy_iterator<true, Key, Value, Max_level>;
+
+		explicit lazy_skip_list(const Compare& comp = Compare(), const Alloc& alloc = Alloc())
+			: compare(comp), allocator(alloc), blocks(alloc)
+		{
+			head = list_node::create_sentinel(blocks, Max_level);
+			try
+			{
+				tail = list_node::create_sentinel(blocks, Max_level);
+			}
+			catch (...)
+			{
+				list_node::destroy(blocks, allocator, head);
+				throw;
+			}
+			for (size_t lvl_index = 0; lvl_index < Max_level; ++lvl_index)
+			{
+				head->set_right_node(lvl_index, tail);
+			}
+		}
+
+		explicit lazy_skip_list(const Alloc& alloc) : lazy_skip_list(Compare(), alloc) {}
+
+		lazy_skip_list(const lazy_skip_list&) = delete;
+		lazy_skip_list& operator=(const lazy_skip_list&) = delete;
+
+		~lazy_skip_list()
+		{
+			domain.reclaim_all();
+			auto current = head;
+			while (current != tail)
+			{
+				auto next = current->get_right_node(0);
+				list_node::destroy(blocks, allocator, current);
+				current = next;
+			}
+			list_node::destroy(blocks, allocator, tail);
+		}
+
+		iterator begin()
+		{
+			auto guard = domain.pin();
+			auto first = head->get_right_node(0);
+			while (first != tail && !first->is_live())
+			{
+				first = first->get_right_node(0);
+			}
+			return iterator(std::move(guard), tail, first);
+		}
+
+		iterator end() { return iterator(domain.pin(), tail, tail); }
+		[[nodiscard]] const_iterator begin() const { return const_cast<lazy_skip_list*>(this)->begin(); }
+		[[nodiscard]] const_iterator end() const { return const_cast<lazy_skip_list*>(this)->end(); }
+		[[nodiscard]] const_iterator cbegin() const { return begin(); }
+		[[nodiscard]] const_iterator cend() const { return end(); }
+
+		[[nodiscard]] size_type size() const noexcept { return list_size.load(std::memory_order_relaxed); }
+		[[nodiscard]] bool empty() const noexcept { return size() == 0; }
+		[[nodiscard]] Alloc get_allocator() const { return allocator; }
+
+		template<typename Pair>
+			requires std::is_convertible_v<std::pair< Key, Value>, std::remove_cvref_t<Pair>>
+		std::pair<iterator, bool> insert(Pair&& value_nods)
+		{
+			const size_t new_lvl = thread_random_level<Level_generator>(Max_level);
+			raise_list_lvl(new_lvl);
+			auto guard = domain.pin();
+			node_array preds{};
+			node_array succs{};
+			list_node* new_node = nullptr;
+			const Key* key = &value_nods.first;
+			while (true)
+			{
+				if (const int found_lvl = search(*key, preds, succs); found_lvl != -1)
+				{
+					auto found_node = succs[found_lvl];
+					if (!found_node->is_marked())
+					{
+						if (new_node != nullptr)
+						{
+							list_node::destroy(blocks, allocator, new_node);
+						}
+						while (!found_node->is_fully_linked())
+						{
+							std::this_thread::yield();
+						}
+						return std::pair<iterator, bool>(iterator(std::move(guard), tail, found_node), false);
+					}
+					continue;
+				}
+				if (new_node == nullptr)
+				{
+					new_node = list_node::create(blocks, allocator, std::forward<Pair>(value_nods), new_lvl);
+					key = &new_node->get_key();
+				}
+				size_t locked_lvl = 0;
+				const bool valid = lock_preds(preds, new_lvl, locked_lvl, [&](const size_t lvl_index)
+					{
+						return !succs[lvl_index]->is_marked() && preds[lvl_index]->get_right_node(lvl_index) == succs[lvl_index];
+					});
+				if (!valid)
+				{
+					unlock_preds(preds, locked_lvl);
+					continue;
+				}
+				for (size_t lvl_index = 0; lvl_index < new_lvl; ++lvl_index)
+				{
+					new_node->set_right_node(lvl_index, succs[lvl_index]);
+				}
+				for (size_t lvl_index = 0; lvl_index < new_lvl; ++lvl_index)
+				{
+					preds[lvl_index]->set_right_node(lvl_index, new_node);
+				}
+				new_node->set_fully_linked();
+				unlock_preds(preds, locked_lvl);
+				list_size.fetch_add(1, std::memory_order_relaxed);
+				return std::pair<iterator, bool>(iterator(std::move(guard), tail, new_node), true);
+			}
+		}
+
+		size_type erase(const Key& key)
+		{
+			auto guard = domain.pin();
+			node_array preds{};
+			node_array succs{};
+			list_node* victim = nullptr;
+			bool is_marked = false;
+			while (true)
+			{
+				const int found_lvl = search(key, preds, succs);
+				if (!is_marked)
+				{
+					if (found_lvl == -1)
+					{
+						return 0;
+					}
+					victim = succs[found_lvl];
+					if (!victim->is_fully_linked() || victim->is_marked() || victim->get_level() != static_cast<size_t>(found_lvl) + 1)
+					{
+						return 0;
+					}
+					victim->lock();
+					if (victim->is_marked())
+					{
+						victim->unlock();
+						return 0;
+					}
+					victim->mark();
+					is_marked = true;
+				}
+				size_t locked_lvl = 0;
+				const bool valid = lock_preds(preds, victim->get_level(), locked_lvl, [&](const size_t lvl_index)
+					{
+						return preds[lvl_index]->get_right_node(lvl_index) == victim;
+					});
+				if (!valid)
+				{
+					unlock_preds(preds, locked_lvl);
+					continue;
+				}
+				for (size_t lvl_index = victim->get_level(); lvl_index-- > 0;)
+				{
+					preds[lvl_index]->set_right_node(lvl_index, victim->get_right_node(lvl_index));
+				}
+				victim->unlock();
+				unlock_preds(preds, locked_lvl);
+				list_size.fetch_sub(1, std::memory_order_relaxed);
+				guard.retire(victim);
+				return 1;
+			}
+		}
+
+		iterator find(const Key& key)
+		{
+			auto guard = domain.pin();
+			return iterator(std::move(guard), tail, search_live(key));
+		}
+
+		[[nodiscard]] const_iterator find(const Key& key) const
+		{
+			return const_cast<lazy_skip_list*>(this)->find(key);
+		}
+
+		[[nodiscard]] size_type count(const Key& key) const
+		{
+			auto guard = domain.pin();
+			return search_live(key) != tail ? 1 : 0;
+		}
+
+		[[nodiscard]] bool contains(const Key& key) const
+		{
+			return count(key) != 0;
+		}
+	};
+
+	template <valid_Key Key,
+		valid_Value Value,
+		typename Compare = std::less<Key>,
+		size_t Max_level = default_max_level,
+		typename Alloc = std::allocator<std::pair<const Key, Value>>,
+		level_generator_policy Level_generator = random_tools::level_generator<>>
+		requires is_compare<Compare, Key>
+	class versioned_skip_list final
+	{
+		struct version
+		{
+			uint64_t sequence;
+			std::optional<Value> value;
+			version* older = nullptr;
+
+			template<typename... Args>
+			explicit version(const uint64_t sequence_, Args&&... args) : sequence(sequence_), value(std::forward<Args>(args)...) {}
+		};
+
+		using version_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<version>;
+		using version_traits = std::allocator_traits<version_allocator>;
+
+		static void destroy_versions(version_allocator& allocator, version* first) noexcept
+		{
+			while (first != nullptr)
+			{
+				auto older = first->older;
+				version_traits::destroy(allocator, first);
+				version_traits::deallocate(allocator, first, 1);
+				first = older;
+			}
+		}
+
+		class version_chain final
+		{
+			SKIP_LIST_NO_UNIQUE_ADDRESS version_allocator allocator;
+			std::atomic<version*> newest{ nullptr };
+			bool pending = false;
+
+			template<typename... Args>
+			version* create_version(const uint64_t sequence, Args&&... args)
+			{
+				auto new_version = std::to_address(version_traits::allocate(allocator, 1));
+				try
+				{
+					version_traits::construct(allocator, new_version, sequence, std::forward<Args>(args)...);
+				}
+				catch (...)
+				{
+					version_traits::deallocate(allocator, new_version, 1);
+					throw;
+				}
+				return new_version;
+			}
+
+		public:
+			explicit version_chain(const Alloc& alloc) : allocator(alloc) {}
+
+			version_chain(const version_chain& other)
+				: allocator(version_traits::select_on_container_copy_construction(other.allocator))
+			{
+				version* copied_newest = nullptr;
+				version* copied_last = nullptr;
+				try
+				{
+					for (auto current = other.newest.load(std::memory_order_acquire); current != nullptr; current = current->older)
+					{
+						auto copied = create_version(current->sequence, current->value);
+						(copied_last == nullptr ? copied_newest : copied_last->older) = copied;
+						copied_last = copied;
+					}
+				}
+				catch (...)
+				{
+					destroy_versions(allocator, copied_newest);
+					throw;
+				}
+				newest.store(copied_newest, std::memory_order_relaxed);
+			}
+
+			version_chain(version_chain&& other) noexcept : allocator(other.allocator),
+				newest(other.newest.exchange(nullptr, std::memory_order_relaxed)), pending(other.pending) {}
+
+			version_chain& operator=(const version_chain&) = delete;
+
+			~version_chain()
+			{
+				destroy_versions(allocator, newest.load(std::memory_order_relaxed));
+			}
+
+			template<typename... Args>
+			void push(const uint64_t sequence, Args&&... args)
+			{
+				auto new_version = create_version(sequence, std::forward<Args>(args)...);
+				new_version->older = newest.load(std::memory_order_relaxed);
+				newest.store(new_version, std::memory_order_release);
+			}
+
+			[[nodiscard]] const version* latest() const noexcept
+			{
+				return newest.load(std::memory_order_acquire);
+			}
+
+			[[nodiscard]] const version* visible(const uint64_t sequence) const noexcept
+			{
+				auto current = newest.load(std::memory_order_acquire);
+				while (current != nullptr && current->sequence > sequence)
+				{
+					current = current->older;
+				}
+				return current;
+			}
+
+			[[nodiscard]] version* prune(const uint64_t oldest_sequence) noexcept
+			{
+				auto current = newest.load(std::memory_order_relaxed);
+				while (current != nullptr && current->sequence > oldest_sequence)
+				{
+					current = current->older;
+				}
+				return current != nullptr ? std::exchange(current->older, nullptr) : nullptr;
+			}
+
+			[[nodiscard]] bool is_erased() const noexcept
+			{
+				const auto current = newest.load(std::memory_order_relaxed);
+				return current != nullptr && current->older == nullptr && !current->value.has_value();
+			}
+
+			[[nodiscard]] bool has_history() const noexcept
+			{
+				const auto current = newest.load(std::memory_order_relaxed);
+				return current != nullptr && (current->older != nullptr || !current->value.has_value());
+			}
+
+			[[nodiscard]] bool is_pending() const noexcept { return pending; }
+			void set_pending(const bool pending_) noexcept { pending = pending_; }
+		};
+
+		using index_allocator = typename std::allocator_traits<Alloc>::template rebind_alloc<std::pair<const Key, version_chain>>;
+		using index_type = skip_list<Key, version_chain, Compare, Max_level, index_allocator, Level_generator, false, true>;
+
+		static constexpr size_t collect_period = 64;
+
+		Alloc allocator;
+		index_type index;
+		version_allocator retired_allocator;
+		std::vector<std::pair<version*, uint64_t>> retired_versions;
+		uint64_t next_sequence = 0;
+		std::atomic<uint64_t> committed{ 0 };
+		size_t live_count = 0;
+		size_t writes_since_collect = 0;
+		std::vector<std::pair<Key, version_chain*>> pending_chains;
+		mutable std::mutex registry_mutex;
+		mutable std::multiset<uint64_t> active_snapshots;
+
+		void track(const Key& key, version_chain& chain)
+		{
+			if (!chain.is_pending() && chain.has_history())
+			{
+				pending_chains.emplace_back(key, &chain);
+				chain.set_pending(true);
+			}
+		}
+
+		void commit(const uint64_t sequence)
+		{
+			next_sequence = sequence;
+			committed.store(sequence, std::memory_order_release);
+			if (++writes_since_collect >= collect_period)
+			{
+				collect_garbage();
+			}
+		}
+
+		void reclaim_versions() noexcept
+		{
+			const uint64_t epoch = index.current_epoch();
+			auto last_safe = std::find_if(retired_versions.begin(), retired_versions.end(), [epoch](const auto& retired)
+				{
+					return retired.second + 2 > epoch;
+				});
+			for (auto retired = retired_versions.begin(); retired != last_safe; ++retired)
+			{
+				destroy_versions(retired_allocator, retired->first);
+			}
+			retired_versions.erase(retired_versions.begin(), last_safe);
+		}
+
+		[[nodiscard]] uint64_t oldest_snapshot() const
+		{
+			std::lock_guard lock(registry_mutex);
+			return active_snapshots.empty() ? committed.load(std::memory_order_relaxed) : *active_snapshots.begin();
+		}
+
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using size_type = std::size_t;
+		using key_compare = Compare;
+		using allocator_type = Alloc;
+
+		class snapshot_iterator final
+		{
+			using index_iterator = typename index_type::const_iterator;
+
+			epoch_domain::guard guard;
+			index_iterator position;
+			index_iterator last;
+			uint64_t sequence;
+			const Key* key = nullptr;
+			const version* current = nullptr;
+
+			void settle()
+			{
+				for (; position != last; ++position)
+				{
+					const auto& entry = *position;
+					current = entry.second.visible(sequence);
+					if (current != nullptr && current->value.has_value())
+					{
+						key = &entry.first;
+						return;
+					}
+				}
+				key = nullptr;
+				current = nullptr;
+			}
+
+		public:
+			using value_type = std::pair<const Key&, const Value&>;
+			using reference = value_type;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::forward_iterator_tag;
+
+			snapshot_iterator(epoch_domain::guard guard_, index_iterator position_, index_iterator last_, const uint64_t sequence_)
+				: guard(std::move(guard_)), position(position_), last(last_), sequence(sequence_)
+			{
+				settle();
+			}
+
+			reference operator*() const
+			{
+				if (current == nullptr)
+				{
+					throw error_dereferencing_end();
+				}
+				return reference(*key, *current->value);
+			}
+
+			snapshot_iterator& operator++()
+			{
+				if (position == last)
+				{
+					throw std::out_of_range("out of range");
+				}
+				++position;
+				settle();
+				return *this;
+			}
+
+			snapshot_iterator operator++(int)
+			{
+				auto previous = *this;
+				++*this;
+				return previous;
+			}
+
+			bool operator==(const snapshot_iterator& other) const noexcept
+			{
+				return position == other.position;
+			}
+
+			bool operator!=(const snapshot_iterator& other) const noexcept
+			{
+				return position != other.position;
+			}
+		};
+
+		class snapshot_view final
+		{
+			const versioned_skip_list* list;
+			uint64_t sequence;
+			std::multiset<uint64_t>::iterator registration;
+
+			friend versioned_skip_list;
+
+			explicit snapshot_view(const versioned_skip_list* list_) : list(list_)
+			{
+				std::lock_guard lock(list->registry_mutex);
+				sequence = list->committed.load(std::memory_order_acquire);
+				registration = list->active_snapshots.insert(sequence);
+			}
+
+		public:
+			snapshot_view(const snapshot_view&) = delete;
+			snapshot_view& operator=(const snapshot_view&) = delete;
+
+			snapshot_view(snapshot_view&& other) noexcept : list(std::exchange(other.list, nullptr)),
+				sequence(other.sequence), registration(other.registration) {}
+
+			~snapshot_view()
+			{
+				if (list != nullptr)
+				{
+					std::lock_guard lock(list->registry_mutex);
+					list->active_snapshots.erase(registration);
+				}
+			}
+
+			[[nodiscard]] uint64_t get_sequence() const noexcept { return sequence; }
+
+			[[nodiscard]] snapshot_iterator begin() const
+			{
+				auto guard = list->index.read_lock();
+				return snapshot_iterator(std::move(guard), list->index.cbegin(), list->index.cend(), sequence);
+			}
+
+			[[nodiscard]] snapshot_iterator end() const
+			{
+				auto guard = list->index.read_lock();
+				return snapshot_iterator(std::move(guard), list->index.cend(), list->index.cend(), sequence);
+			}
+
+			[[nodiscard]] snapshot_iterator lower_bound(const Key& key) const
+			{
+				auto guard = list->index.read_lock();
+				return snapshot_iterator(std::move(guard), list->index.lower_bound(key), list->index.cend(), sequence);
+			}
+
+			[[nodiscard]] std::optional<Value> find(const Key& key) const
+			{
+				auto guard = list->index.read_lock();
+				auto position = list->index.find(key);
+				if (position == list->index.cend())
+				{
+					return std::nullopt;
+				}
+				auto found = (*position).second.visible(sequence);
+				return found != nullptr ? found->value : std::nullopt;
+			}
+
+			[[nodiscard]] bool contains(const Key& key) const
+			{
+				return find(key).has_value();
+			}
+		};
+
+		explicit versioned_skip_list(const Compare& comp = Compare(), const Alloc& alloc = Alloc())
+			: allocator(alloc), index(comp, index_allocator(alloc)), retired_allocator(alloc) {}
+
+		explicit versioned_skip_list(const Alloc& alloc) : versioned_skip_list(Compare(), alloc) {}
+
+		versioned_skip_list(const versioned_skip_list&) = delete;
+		versioned_skip_list& operator=(const versioned_skip_list&) = delete;
+
+		~versioned_skip_list()
+		{
+			for (const auto& retired : retired_versions)
+			{
+				destroy_versions(retired_allocator, retired.first);
+			}
+		}
+
+		[[nodiscard]] snapshot_view snapshot() const
+		{
+			return snapshot_view(this);
+		}
+
+		template<typename Value_>
+			requires std::constructible_from<Value, Value_&&>
+		bool insert_or_assign(const Key& key, Value_&& value)
+		{
+			const uint64_t sequence = next_sequence + 1;
+			auto position = index.find(key);
+			bool inserted = true;
+			if (position == index.end())
+			{
+				version_chain chain(allocator);
+				chain.push(sequence, std::forward<Value_>(value));
+				index.insert(std::pair<Key, version_chain>(key, std::move(chain)));
+			}
+			else
+			{
+				auto& chain = (*position).second;
+				inserted = !chain.latest()->value.has_value();
+				chain.push(sequence, std::forward<Value_>(value));
+				track(key, chain);
+			}
+			live_count += inserted ? 1 : 0;
+			commit(sequence);
+			return inserted;
+		}
+
+		bool erase(const Key& key)
+		{
+			auto position = index.find(key);
+			if (position == index.end() || !(*position).second.latest()->value.has_value())
+			{
+				return false;
+			}
+			const uint64_t sequence = next_sequence + 1;
+			auto& chain = (*position).second;
+			chain.push(sequence, std::nullopt);
+			track(key, chain);
+			--live_count;
+			commit(sequence);
+			return true;
+		}
+
+		[[nodiscard]] std::optional<Value> find(const Key& key) const
+		{
+			auto guard = index.read_lock();
+			auto position = index.find(key);
+			if (position == index.cend())
+			{
+				return std::nullopt;
+			}
+			return (*position).second.latest()->value;
+		}
+
+		[[nodiscard]] bool contains(const Key& key) const
+		{
+			return find(key).has_value();
+		}
+
+		void collect_garbage()
+		{
+			writes_since_collect = 0;
+			const uint64_t oldest_sequence = oldest_snapshot();
+			const uint64_t epoch = index.current_epoch();
+			retired_versions.reserve(retired_versions.size() + pending_chains.size());
+			size_t kept = 0;
+			for (size_t index_ = 0; index_ < pending_chains.size(); ++index_)
+			{
+				auto& [key, chain] = pending_chains[index_];
+				if (auto superseded = chain->prune(oldest_sequence); superseded != nullptr)
+				{
+					retired_versions.emplace_back(superseded, epoch);
+				}
+				if (chain->is_erased())
+				{
+					index.erase(key);
+					continue;
+				}
+				if (!chain->has_history())
+				{
+					chain->set_pending(false);
+					continue;
+				}
+				if (kept != index_)
+				{
+					pending_chains[kept] = std::move(pending_chains[index_]);
+				}
+				++kept;
+			}
+			pending_chains.erase(pending_chains.begin() + static_cast<std::ptrdiff_t>(kept), pending_chains.end());
+			index.reclaim_retired();
+			reclaim_versions();
+		}
+
+		[[nodiscard]] size_type size() const noexcept { return live_count; }
+		[[nodiscard]] bool empty() const noexcept { return live_count == 0; }
+		[[nodiscard]] uint64_t get_sequence() const noexcept { return committed.load(std::memory_order_acquire); }
+		[[nodiscard]] Alloc get_allocator() const { return allocator; }
+	};
+
+	template <valid_Key Key,
+		valid_Value Value,
+		typename Compare = std::less<Key>,
+		size_t Max_level = default_max_level,
+		typename Alloc = std::allocator<std::pair<const Key, Value>>,
+		level_generator_policy Level_generator = random_tools::level_generator<>>
+		requires is_compare<Compare, Key>
+	class sharded_skip_list final
+	{
+		using shard_list = skip_list<Key, Value, Compare, Max_level, Alloc, Level_generator>;
+
+		struct shard
+		{
+			mutable std::shared_mutex mutex;
+			shard_list list;
+
+			shard(const Compare& comp, const Alloc& alloc) : list(comp, alloc) {}
+			shard(shard_list&& list_) : list(std::move(list_)) {}
+		};
+
+		mutable std::shared_mutex directory_mutex;
+		std::vector<Key> split_keys;
+		std::vector<std::unique_ptr<shard>> shards;
+		std::atomic<size_t> total_size{ 0 };
+		size_t split_threshold;
+		Compare compare;
+		Alloc allocator;
+
+		[[nodiscard]] size_t shard_index(const Key& key) const
+		{
+			return static_cast<size_t>(std::upper_bound(split_keys.begin(), split_keys.end(), key, compare) - split_keys.begin());
+		}
+
+		[[nodiscard]] shard& route(const Key& key) const
+		{
+			return *shards[shard_index(key)];
+		}
+
+		void split_if_needed(const Key& key)
+		{
+			std::unique_lock lock(directory_mutex);
+			const size_t index = shard_index(key);
+			auto& full = shards[index]->list;
+			if (full.size() <= split_threshold)
+			{
+				return;
+			}
+			auto middle = full.begin();
+			std::advance(middle, static_cast<std::ptrdiff_t>(full.size() / 2));
+			Key split_key = (*middle).first;
+			std::vector<std::pair<Key, Value>> moved;
+			moved.reserve(full.size() - full.size() / 2);
+			for (auto position = middle; position != full.end(); ++position)
+			{
+				moved.emplace_back((*position).first, std::move((*position).second));
+			}
+			auto upper = std::make_unique<shard>(shard_list(sorted_unique, moved.begin(), moved.end(), compare, allocator));
+			full.erase(middle, full.end());
+			split_keys.insert(split_keys.begin() + static_cast<std::ptrdiff_t>(index), std::move(split_key));
+			shards.insert(shards.begin() + static_cast<std::ptrdiff_t>(index) + 1, std::move(upper));
+		}
+
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using value_type = std::pair<const Key, Value>;
+		using size_type = std::size_t;
+		using key_compare = Compare;
+		using allocator_type = Alloc;
+
+		static constexpr size_t default_split_threshold = 1 << 16;
+
+		explicit sharded_skip_list(const size_t split_threshold_ = default_split_threshold, const Compare& comp = Compare(), const Alloc& alloc = Alloc())
+			: sharded_skip_list(std::vector<Key>(), split_threshold_, comp, alloc) {}
+
+		explicit sharded_skip_list(std::vector<Key> split_keys_, const size_t split_threshold_ = default_split_threshold,
+			const Compare& comp = Compare(), const Alloc& alloc = Alloc())
+			: split_keys(std::move(split_keys_)), split_threshold(std::max<size_t>(split_threshold_, 2)), compare(comp), allocator(alloc)
+		{
+			std::sort(split_keys.begin(), split_keys.end(), compare);
+			split_keys.erase(std::unique(split_keys.begin(), split_keys.end(),
+				[this](const Key& left, const Key& right) { return !compare(left, right) && !compare(right, left); }), split_keys.end());
+			shards.reserve(split_keys.size() + 1);
+			for (size_t index = 0; index <= split_keys.size(); ++index)
+			{
+				shards.push_back(std::make_unique<shard>(compare, allocator));
+			}
+		}
+
+		sharded_skip_list(const sharded_skip_list&) = delete;
+		sharded_skip_list& operator=(const sharded_skip_list&) = delete;
+
+		template<class Pair>
+			requires std::is_convertible_v<std::pair<Key, Value>, std::remove_cvref_t<Pair>>
+		bool insert(Pair&& value_nods)
+		{
+			const Key key = value_nods.first;
+			size_t shard_size;
+			{
+				std::shared_lock directory_lock(directory_mutex);
+				auto& target = route(key);
+				std::unique_lock shard_lock(target.mutex);
+				if (!target.list.insert(std::forward<Pair>(value_nods)).second)
+				{
+					return false;
+				}
+				shard_size = target.list.size();
+			}
+			total_size.fetch_add(1, std::memory_order_relaxed);
+			if (shard_size > split_threshold)
+			{
+				split_if_needed(key);
+			}
+			return true;
+		}
+
+		template<typename Value_>
+			requires std::constructible_from<Value, Value_&&>
+		bool insert_or_assign(const Key& key, Value_&& value)
+		{
+			size_t shard_size;
+			{
+				std::shared_lock directory_lock(directory_mutex);
+				auto& target = route(key);
+				std::unique_lock shard_lock(target.mutex);
+				if (auto position = target.list.find(key); position != target.list.end())
+				{
+					(*position).second = std::forward<Value_>(value);
+					return false;
+				}
+				target.list.insert(std::pair<Key, Value>(key, std::forward<Value_>(value)));
+				shard_size = target.list.size();
+			}
+			total_size.fetch_add(1, std::memory_order_relaxed);
+			if (shard_size > split_threshold)
+			{
+				split_if_needed(key);
+			}
+			return true;
+		}
+
+		bool erase(const Key& key)
+		{
+			std::shared_lock directory_lock(directory_mutex);
+			auto& target = route(key);
+			std::unique_lock shard_lock(target.mutex);
+			const size_t old_size = target.list.size();
+			if (target.list.erase(key) == old_size)
+			{
+				return false;
+			}
+			total_size.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+
+		[[nodiscard]] std::optional<Value> find(const Key& key) const
+		{
+			std::shared_lock directory_lock(directory_mutex);
+			const auto& target = route(key);
+			std::shared_lock shard_lock(target.mutex);
+			const auto& list = target.list;
+			if (auto position = list.find(key); position != list.end())
+			{
+				return (*position).second;
+			}
+			return std::nullopt;
+		}
+
+		[[nodiscard]] bool contains(const Key& key) const
+		{
+			std::shared_lock directory_lock(directory_mutex);
+			const auto& target = route(key);
+			std::shared_lock shard_lock(target.mutex);
+			const auto& list = target.list;
+			return list.find(key) != list.end();
+		}
+
+		template<typename Func>
+			requires std::invocable<Func&, const Key&, const Value&>
+		void for_each(Func&& func) const
+		{
+			std::shared_lock directory_lock(directory_mutex);
+			for (const auto& current : shards)
+			{
+				std::shared_lock shard_lock(current->mutex);
+				for (const auto& [key, value] : current->list)
+				{
+					func(key, value);
+				}
+			}
+		}
+
+		template<typename Func>
+			requires std::invocable<Func&, const Key&, const Value&>
+		void for_each_in_range(const Key& first, const Key& last, Func&& func) const
+		{
+			if (!compare(first, last))
+			{
+				return;
+			}
+			std::shared_lock directory_lock(directory_mutex);
+			for (size_t index = shard_index(first); index < shards.size(); ++index)
+			{
+				if (index != 0 && !compare(split_keys[index - 1], last))
+				{
+					break;
+				}
+				std::shared_lock shard_lock(shards[index]->mutex);
+				const auto& list = shards[index]->list;
+				for (auto position = list.lower_bound(first); position != list.end(); ++position)
+				{
+					const auto& [key, value] = *position;
+					if (!compare(key, last))
+					{
+						break;
+					}
+					func(key, value);
+				}
+			}
+		}
+
+		void clear()
+		{
+			std::unique_lock lock(directory_mutex);
+			for (auto& current : shards)
+			{
+				current->list.clear();
+			}
+			total_size.store(0, std::memory_order_relaxed);
+		}
+
+		[[nodiscard]] size_type size() const noexcept { return total_size.load(std::memory_order_relaxed); }
+		[[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+		[[nodiscard]] size_type shard_count() const
+		{
+			std::shared_lock lock(directory_mutex);
+			return shards.size();
+		}
+
+		[[nodiscard]] std::vector<Key> get_split_keys() const
+		{
+			std::shared_lock lock(directory_mutex);
+			return split_keys;
+		}
+
+		[[nodiscard]] Alloc get_allocator() const { return allocator; }
+	};
+}
@@ -0,0 +1,248 @@
+#pragma once
+#include <atomic>
+#include <array>
+#include <thread>
+#include <cstdint>
+#include <utility>
+
+namespace skip_list_space
+{
+	struct retired_object
+	{
+		retired_object* next_retired = nullptr;
+		uint64_t retire_epoch = 0;
+	};
+
+	class epoch_domain final
+	{
+	public:
+		using reclaimer = void (*)(retired_object*, void*) noexcept;
+
+	private:
+		struct participant
+		{
+			std::atomic<uint64_t> state{ 0 };
+			std::thread::id owner;
+			participant* next = nullptr;
+			size_t nesting = 0;
+			size_t retired_count = 0;
+		};
+
+		struct cached_participant
+		{
+			uint64_t domain_id = 0;
+			participant* record = nullptr;
+		};
+
+		static constexpr uint64_t active_bit = 1;
+		static constexpr size_t collect_period = 64;
+		static constexpr size_t thread_cache_size = 8;
+
+		inline static std::atomic<uint64_t> next_domain_id{ 1 };
+
+		std::atomic<uint64_t> global_epoch{ 0 };
+		std::atomic<participant*> participants{ nullptr };
+		std::array<std::atomic<retired_object*>, 3> retired{};
+		reclaimer reclaim;
+		void* context;
+		uint64_t domain_id = next_domain_id.fetch_add(1, std::memory_order_relaxed);
+
+		participant& local_participant()
+		{
+			thread_local std::array<cached_participant, thread_cache_size> cache{};
+			thread_local size_t cache_victim = 0;
+			for (auto& entry : cache)
+			{
+				if (entry.domain_id == domain_id)
+				{
+					return *entry.record;
+				}
+			}
+			const auto id = std::this_thread::get_id();
+			participant* record = participants.load(std::memory_order_acquire);
+			while (record != nullptr && record->owner != id)
+			{
+				record = record->next;
+			}
+			if (record == nullptr)
+			{
+				record = new participant();
+				record->owner = id;
+				record->next = participants.load(std::memory_order_relaxed);
+				while (!participants.compare_exchange_weak(record->next, record, std::memory_order_release, std::memory_order_relaxed)) {}
+			}
+			cache[cache_victim] = cached_participant{ domain_id, record };
+			cache_victim = (cache_victim + 1) % thread_cache_size;
+			return *record;
+		}
+
+		void enter(participant& self) noexcept
+		{
+			if (self.nesting++ != 0)
+			{
+				return;
+			}
+			uint64_t epoch = global_epoch.load(std::memory_order_relaxed);
+			while (true)
+			{
+				self.state.store(epoch << 1 | active_bit);
+				const uint64_t current = global_epoch.load();
+				if (current == epoch)
+				{
+					return;
+				}
+				epoch = current;
+			}
+		}
+
+		static void leave(participant& self) noexcept
+		{
+			if (--self.nesting == 0)
+			{
+				self.state.store(0, std::memory_order_release);
+			}
+		}
+
+		void push_retired(retired_object* object) noexcept
+		{
+			auto& slot = retired[object->retire_epoch % retired.size()];
+			object->next_retired = slot.load(std::memory_order_relaxed);
+			while (!slot.compare_exchange_weak(object->next_retired, object, std::memory_order_release, std::memory_order_relaxed)) {}
+		}
+
+		void collect(const uint64_t epoch) noexcept
+		{
+			if (reclaim == nullptr)
+			{
+				return;
+			}
+			auto object = retired[(epoch + 1) % retired.size()].exchange(nullptr, std::memory_order_acquire);
+			while (object != nullptr)
+			{
+				auto next = object->next_retired;
+				if (object->retire_epoch + 2 <= epoch)
+				{
+					reclaim(object, context);
+				}
+				else
+				{
+					push_retired(object);
+				}
+				object = next;
+			}
+		}
+
+	public:
+		class guard final
+		{
+			epoch_domain* domain;
+			participant* self;
+
+			friend epoch_domain;
+			guard(epoch_domain* domain_, participant* self_) noexcept : domain(domain_), self(self_) {}
+
+		public:
+			guard() noexcept : domain(nullptr), self(nullptr) {}
+
+			guard(const guard& other) : guard(other.domain != nullptr ? other.domain->pin() : guard()) {}
+
+			guard(guard&& other) noexcept : domain(std::exchange(other.domain, nullptr)), self(std::exchange(other.self, nullptr)) {}
+
+			guard& operator=(guard other) noexcept
+			{
+				std::swap(domain, other.domain);
+				std::swap(self, other.self);
+				return *this;
+			}
+
+			~guard()
+			{
+				if (self != nullptr)
+				{
+					leave(*self);
+				}
+			}
+
+			void retire(retired_object* object) noexcept
+			{
+				object->retire_epoch = domain->global_epoch.load();
+				domain->push_retired(object);
+				if (++self->retired_count % collect_period == 0)
+				{
+					domain->try_advance();
+				}
+			}
+		};
+
+		epoch_domain() noexcept : epoch_domain(nullptr, nullptr) {}
+		epoch_domain(const reclaimer reclaim_, void* context_) noexcept : reclaim(reclaim_), context(context_) {}
+
+		epoch_domain(const epoch_domain&) = delete;
+		epoch_domain& operator=(const epoch_domain&) = delete;
+
+		~epoch_domain()
+		{
+			reclaim_all();
+			auto record = participants.exchange(nullptr);
+			while (record != nullptr)
+			{
+				delete std::exchange(record, record->next);
+			}
+		}
+
+		[[nodiscard]] guard pin()
+		{
+			auto& self = local_participant();
+			enter(self);
+			return guard(this, &self);
+		}
+
+		[[nodiscard]] uint64_t current_epoch() const noexcept
+		{
+			return global_epoch.load();
+		}
+
+		bool try_advance() noexcept
+		{
+			uint64_t epoch = global_epoch.load();
+			for (auto record = participants.load(std::memory_order_acquire); record != nullptr; record = record->next)
+			{
+				const uint64_t state = record->state.load();
+				if ((state & active_bit) != 0 && (state >> 1) != epoch)
+				{
+					return false;
+				}
+			}
+			if (!global_epoch.compare_exchange_strong(epoch, epoch + 1))
+			{
+				return false;
+			}
+			collect(epoch + 1);
+			return true;
+		}
+
+		void synchronize() noexcept
+		{
+			for (size_t step = 0; step < retired.size(); ++step)
+			{
+				try_advance();
+			}
+		}
+
+		void reclaim_all() noexcept
+		{
+			if (reclaim == nullptr)
+			{
+				return;
+			}
+			for (auto& slot : retired)
+			{
+				auto object = slot.exchange(nullptr);
+				while (object != nullptr)
+				{
+					reclaim(std::exchange(object, object->next_retired), context);
+				}
+			}
+		}
+	};
+}
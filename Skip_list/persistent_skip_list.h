@@ -0,0 +1,581 @@
+#pragma once
+#include <array>
+#include <algorithm>
+#include <string>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <system_error>
+#include "Skip_list.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace skip_list_space
+{
+	class mapped_file final
+	{
+		std::byte* base = nullptr;
+		size_t length = 0;
+		bool created = false;
+#ifdef _WIN32
+		HANDLE file = INVALID_HANDLE_VALUE;
+		HANDLE mapping = nullptr;
+
+		[[noreturn]] static void throw_last_error(const char* what)
+		{
+			throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), what);
+		}
+
+		void map(const size_t new_length)
+		{
+			const HANDLE new_mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE,
+				static_cast<DWORD>(static_cast<uint64_t>(new_length) >> 32), static_cast<DWORD>(new_length & 0xFFFFFFFFu), nullptr);
+			if (new_mapping == nullptr)
+			{
+				throw_last_error("CreateFileMapping");
+			}
+			const auto new_base = static_cast<std::byte*>(MapViewOfFile(new_mapping, FILE_MAP_ALL_ACCESS, 0, 0, new_length));
+			if (new_base == nullptr)
+			{
+				const auto error = GetLastError();
+				CloseHandle(new_mapping);
+				throw std::system_error(static_cast<int>(error), std::system_category(), "MapViewOfFile");
+			}
+			unmap();
+			mapping = new_mapping;
+			base = new_base;
+			length = new_length;
+		}
+
+		void unmap() noexcept
+		{
+			if (base != nullptr)
+			{
+				UnmapViewOfFile(base);
+				base = nullptr;
+			}
+			if (mapping != nullptr)
+			{
+				CloseHandle(mapping);
+				mapping = nullptr;
+			}
+		}
+
+		void close() noexcept
+		{
+			unmap();
+			if (file != INVALID_HANDLE_VALUE)
+			{
+				CloseHandle(file);
+				file = INVALID_HANDLE_VALUE;
+			}
+		}
+#else
+		int descriptor = -1;
+
+		[[noreturn]] static void throw_last_error(const char* what)
+		{
+			throw std::system_error(errno, std::generic_category(), what);
+		}
+
+		void map(const size_t new_length)
+		{
+			void* address = mmap(nullptr, new_length, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+			if (address == MAP_FAILED)
+			{
+				throw_last_error("mmap");
+			}
+			unmap();
+			base = static_cast<std::byte*>(address);
+			length = new_length;
+		}
+
+		void unmap() noexcept
+		{
+			if (base != nullptr)
+			{
+				munmap(base, length);
+				base = nullptr;
+			}
+		}
+
+		void close() noexcept
+		{
+			unmap();
+			if (descriptor != -1)
+			{
+				::close(descriptor);
+				descriptor = -1;
+			}
+		}
+#endif
+
+	public:
+		mapped_file(const std::string& path, const size_t minimum_length)
+		{
+#ifdef _WIN32
+			file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+			if (file == INVALID_HANDLE_VALUE)
+			{
+				throw_last_error("CreateFile");
+			}
+			LARGE_INTEGER file_size{};
+			if (!GetFileSizeEx(file, &file_size))
+			{
+				close();
+				throw_last_error("GetFileSizeEx");
+			}
+			const auto existing_length = static_cast<size_t>(file_size.QuadPart);
+#else
+			descriptor = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+			if (descriptor == -1)
+			{
+				throw_last_error("open");
+			}
+			struct stat file_status {};
+			if (fstat(descriptor, &file_status) != 0)
+			{
+				close();
+				throw_last_error("fstat");
+			}
+			const auto existing_length = static_cast<size_t>(file_status.st_size);
+#endif
+			created = existing_length == 0;
+			try
+			{
+				if (created)
+				{
+					resize(minimum_length);
+				}
+				else
+				{
+					map(existing_length);
+				}
+			}
+			catch (...)
+			{
+				close();
+				throw;
+			}
+		}
+
+		mapped_file(const mapped_file&) = delete;
+		mapped_file& operator=(const mapped_file&) = delete;
+
+		~mapped_file()
+		{
+			close();
+		}
+
+		void resize(const size_t new_length)
+		{
+#ifdef _WIN32
+			LARGE_INTEGER position{};
+			position.QuadPart = static_cast<LONGLONG>(new_length);
+			if (!SetFilePointerEx(file, position, nullptr, FILE_BEGIN) || !SetEndOfFile(file))
+			{
+				throw_last_error("SetEndOfFile");
+			}
+#else
+			if (ftruncate(descriptor, static_cast<off_t>(new_length)) != 0)
+			{
+				throw_last_error("ftruncate");
+			}
+#endif
+			map(new_length);
+		}
+
+		void flush()
+		{
+#ifdef _WIN32
+			if (!FlushViewOfFile(base, 0) || !FlushFileBuffers(file))
+			{
+				throw_last_error("FlushViewOfFile");
+			}
+#else
+			if (msync(base, length, MS_SYNC) != 0)
+			{
+				throw_last_error("msync");
+			}
+#endif
+		}
+
+		[[nodiscard]] std::byte* data() const noexcept { return base; }
+		[[nodiscard]] size_t size() const noexcept { return length; }
+		[[nodiscard]] bool is_created() const noexcept { return created; }
+	};
+
+	template <typename T>
+	struct relative_ptr
+	{
+		std::ptrdiff_t offset = 0;
+
+		[[nodiscard]] T* get() const noexcept
+		{
+			if (offset == 0)
+			{
+				return nullptr;
+			}
+			return reinterpret_cast<T*>(reinterpret_cast<std::uintptr_t>(this) + static_cast<std::uintptr_t>(offset));
+		}
+
+		void set(const T* target) noexcept
+		{
+			offset = target == nullptr ? 0 :
+				static_cast<std::ptrdiff_t>(reinterpret_cast<std::uintptr_t>(target) - reinterpret_cast<std::uintptr_t>(this));
+		}
+	};
+
+	template <typename Key, typename Value>
+	struct persistent_node
+	{
+		Key key;
+		Value value;
+		uint32_t level;
+
+		[[nodiscard]] static constexpr size_t links_offset() noexcept
+		{
+			constexpr size_t link_alignment = alignof(relative_ptr<persistent_node>);
+			return (sizeof(persistent_node) + link_alignment - 1) / link_alignment * link_alignment;
+		}
+
+		[[nodiscard]] static constexpr size_t allocation_size(const size_t lvl) noexcept
+		{
+			const size_t bytes = links_offset() + lvl * sizeof(relative_ptr<persistent_node>);
+			return (bytes + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+		}
+
+		[[nodiscard]] relative_ptr<persistent_node>* links() noexcept
+		{
+			return reinterpret_cast<relative_ptr<persistent_node>*>(reinterpret_cast<std::byte*>(this) + links_offset());
+		}
+
+		[[nodiscard]] const relative_ptr<persistent_node>* links() const noexcept
+		{
+			return reinterpret_cast<const relative_ptr<persistent_node>*>(reinterpret_cast<const std::byte*>(this) + links_offset());
+		}
+
+		[[nodiscard]] persistent_node* get_right_node(const size_t lvl_index) const noexcept
+		{
+			return links()[lvl_index].get();
+		}
+
+		void set_right_node(const size_t lvl_index, const persistent_node* node) noexcept
+		{
+			links()[lvl_index].set(node);
+		}
+
+		[[nodiscard]] const Key& get_key() const noexcept { return key; }
+	};
+
+	template <typename Key,
+		typename Value,
+		typename Compare = std::less<Key>,
+		size_t Max_level = default_max_level,
+		level_generator_policy Level_generator = random_tools::level_generator<>>
+		requires std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<Value> && is_compare<Compare, Key>
+	class persistent_skip_list final
+	{
+		using node = persistent_node<Key, Value>;
+
+		struct file_header
+		{
+			uint64_t magic;
+			uint32_t format_version;
+			uint32_t max_level;
+			uint64_t key_size;
+			uint64_t value_size;
+			uint64_t used;
+			uint64_t size;
+			uint64_t level;
+			std::array<relative_ptr<node>, Max_level> free_lists;
+		};
+
+		static constexpr uint64_t file_magic = 0x5453494C50494B53;
+		static constexpr uint32_t format_version = 1;
+		static constexpr size_t head_offset = (sizeof(file_header) + alignof(std::max_align_t) - 1)
+			/ alignof(std::max_align_t) * alignof(std::max_align_t);
+		static constexpr size_t data_offset = head_offset + node::allocation_size(Max_level);
+
+		mapped_file file;
+		Compare compare;
+		Level_generator level_generator{};
+
+		[[nodiscard]] file_header& header() const noexcept
+		{
+			return *reinterpret_cast<file_header*>(file.data());
+		}
+
+		[[nodiscard]] node* head() const noexcept
+		{
+			return reinterpret_cast<node*>(file.data() + head_offset);
+		}
+
+		void format()
+		{
+			std::memset(file.data(), 0, data_offset);
+			auto& current = header();
+			current.magic = file_magic;
+			current.format_version = format_version;
+			current.max_level = static_cast<uint32_t>(Max_level);
+			current.key_size = sizeof(Key);
+			current.value_size = sizeof(Value);
+			current.used = data_offset;
+			current.level = 1;
+			head()->level = static_cast<uint32_t>(Max_level);
+		}
+
+		void validate() const
+		{
+			if (file.size() < data_offset)
+			{
+				throw std::runtime_error("skip list file is truncated");
+			}
+			const auto& current = header();
+			if (current.magic != file_magic || current.format_version != format_version || current.max_level != Max_level ||
+				current.key_size != sizeof(Key) || current.value_size != sizeof(Value) ||
+				current.used < data_offset || current.used > file.size() || current.level == 0 || current.level > Max_level)
+			{
+				throw std::runtime_error("skip list file has an incompatible layout");
+			}
+		}
+
+		void reserve_node(const size_t lvl)
+		{
+			auto& current = header();
+			const size_t bytes = node::allocation_size(lvl);
+			if (current.free_lists[lvl - 1].get() == nullptr && current.used + bytes > file.size())
+			{
+				file.resize((std::max)(file.size() * 2, static_cast<size_t>(current.used) + bytes));
+			}
+		}
+
+		[[nodiscard]] node* allocate_node(const size_t lvl) noexcept
+		{
+			auto& current = header();
+			auto& free_list = current.free_lists[lvl - 1];
+			node* new_node = free_list.get();
+			if (new_node != nullptr)
+			{
+				free_list.set(new_node->get_right_node(0));
+			}
+			else
+			{
+				new_node = reinterpret_cast<node*>(file.data() + current.used);
+				current.used += node::allocation_size(lvl);
+			}
+			std::memset(static_cast<void*>(new_node), 0, node::allocation_size(lvl));
+			new_node->level = static_cast<uint32_t>(lvl);
+			return new_node;
+		}
+
+		void free_node(node* old_node) noexcept
+		{
+			auto& free_list = header().free_lists[old_node->level - 1];
+			old_node->set_right_node(0, free_list.get());
+			free_list.set(old_node);
+		}
+
+		[[nodiscard]] node* search_lower_bound(const Key& key) const
+		{
+			auto current = head();
+			for (int lvl_index = static_cast<int>(header().level) - 1; lvl_index >= 0; --lvl_index)
+			{
+				current = next_less_key_element(current, lvl_index, key, static_cast<const node*>(nullptr), compare);
+			}
+			return current->get_right_node(0);
+		}
+
+		[[nodiscard]] node* search_key_storing_past_elements(const Key& key, std::array<node*, Max_level>& updated_nods) const
+		{
+			auto current = head();
+			for (int lvl_index = static_cast<int>(Max_level) - 1; lvl_index >= 0; --lvl_index)
+			{
+				if (static_cast<uint64_t>(lvl_index) < header().level)
+				{
+					current = next_less_key_element(current, lvl_index, key, static_cast<const node*>(nullptr), compare);
+				}
+				updated_nods[lvl_index] = current;
+			}
+			return current->get_right_node(0);
+		}
+
+		[[nodiscard]] bool is_equal(const node* found, const Key& key) const
+		{
+			return found != nullptr && !compare(key, found->key);
+		}
+
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using size_type = std::size_t;
+		using key_compare = Compare;
+
+		static constexpr size_t default_capacity = 1 << 20;
+
+		class const_iterator final
+		{
+			const node* current = nullptr;
+
+		public:
+			using value_type = std::pair<const Key&, const Value&>;
+			using reference = value_type;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::forward_iterator_tag;
+
+			const_iterator() = default;
+			explicit const_iterator(const node* current_) noexcept : current(current_) {}
+
+			reference operator*() const
+			{
+				if (current == nullptr)
+				{
+					throw error_dereferencing_end();
+				}
+				return reference(current->key, current->value);
+			}
+
+			const_iterator& operator++()
+			{
+				if (current == nullptr)
+				{
+					throw std::out_of_range("out of range");
+				}
+				current = current->get_right_node(0);
+				return *this;
+			}
+
+			const_iterator operator++(int)
+			{
+				auto previous = *this;
+				++*this;
+				return previous;
+			}
+
+			bool operator==(const const_iterator& other) const noexcept { return current == other.current; }
+			bool operator!=(const const_iterator& other) const noexcept { return current != other.current; }
+		};
+
+		explicit persistent_skip_list(const std::string& path, const size_t initial_capacity = default_capacity, const Compare& comp = Compare())
+			: file(path, (std::max)(initial_capacity, data_offset)), compare(comp)
+		{
+			if (file.is_created())
+			{
+				format();
+			}
+			else
+			{
+				validate();
+			}
+		}
+
+		persistent_skip_list(const persistent_skip_list&) = delete;
+		persistent_skip_list& operator=(const persistent_skip_list&) = delete;
+
+		bool insert(const Key& key, const Value& value)
+		{
+			const size_t lvl = std::clamp<size_t>(level_generator(Max_level), 1, Max_level);
+			reserve_node(lvl);
+			std::array<node*, Max_level> updated_nods;
+			if (is_equal(search_key_storing_past_elements(key, updated_nods), key))
+			{
+				return false;
+			}
+			auto new_node = allocate_node(lvl);
+			std::memcpy(static_cast<void*>(&new_node->key), &key, sizeof(Key));
+			std::memcpy(static_cast<void*>(&new_node->value), &value, sizeof(Value));
+			for (size_t lvl_index = 0; lvl_index < lvl; ++lvl_index)
+			{
+				new_node->set_right_node(lvl_index, updated_nods[lvl_index]->get_right_node(lvl_index));
+				updated_nods[lvl_index]->set_right_node(lvl_index, new_node);
+			}
+			auto& current = header();
+			current.level = (std::max)(static_cast<uint64_t>(lvl), current.level);
+			++current.size;
+			return true;
+		}
+
+		bool insert_or_assign(const Key& key, const Value& value)
+		{
+			if (auto found = search_lower_bound(key); is_equal(found, key))
+			{
+				std::memcpy(static_cast<void*>(&found->value), &value, sizeof(Value));
+				return false;
+			}
+			return insert(key, value);
+		}
+
+		bool erase(const Key& key)
+		{
+			std::array<node*, Max_level> updated_nods;
+			auto found = search_key_storing_past_elements(key, updated_nods);
+			if (!is_equal(found, key))
+			{
+				return false;
+			}
+			for (size_t lvl_index = 0; lvl_index < found->level; ++lvl_index)
+			{
+				updated_nods[lvl_index]->set_right_node(lvl_index, found->get_right_node(lvl_index));
+			}
+			free_node(found);
+			auto& current = header();
+			while (current.level > 1 && head()->get_right_node(current.level - 1) == nullptr)
+			{
+				--current.level;
+			}
+			--current.size;
+			return true;
+		}
+
+		void clear()
+		{
+			format();
+		}
+
+		[[nodiscard]] const_iterator find(const Key& key) const
+		{
+			auto found = search_lower_bound(key);
+			return is_equal(found, key) ? const_iterator(found) : end();
+		}
+
+		[[nodiscard]] bool contains(const Key& key) const
+		{
+			return is_equal(search_lower_bound(key), key);
+		}
+
+		[[nodiscard]] const_iterator lower_bound(const Key& key) const
+		{
+			return const_iterator(search_lower_bound(key));
+		}
+
+		[[nodiscard]] const_iterator begin() const noexcept { return const_iterator(head()->get_right_node(0)); }
+		[[nodiscard]] const_iterator end() const noexcept { return const_iterator(); }
+
+		void flush()
+		{
+			file.flush();
+		}
+
+		[[nodiscard]] size_type size() const noexcept { return static_cast<size_type>(header().size); }
+		[[nodiscard]] bool empty() const noexcept { return size() == 0; }
+		[[nodiscard]] size_type capacity() const noexcept { return file.size(); }
+	};
+}
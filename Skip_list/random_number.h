@@ -1,13 +1,15 @@
 #pragma once
+#include <bit>
+#include <array>
+#include <ratio>
 #include <random>
+#include <cstdint>
+#include <algorithm>
 
 namespace random_tools
 {
 	namespace impl
 	{
-		constexpr double parameter = 1 / 2.;
-		constexpr double min = 0.0;
-		constexpr double max = 1.0;
 		template<typename type>
 		double get_random_number(const type min_lvl, const type max_lvl, std::mt19937& gen) noexcept{
 
@@ -15,16 +17,105 @@ namespace random_tools
 			return distribution(gen);
 		}
 
+		template<typename Probability>
+		constexpr bool is_power_of_two_reciprocal = Probability::num == 1 && std::has_single_bit(static_cast<uintmax_t>(Probability::den));
+
+		template<typename Probability, unsigned Bits>
+		constexpr auto make_promotion_thresholds() noexcept
+		{
+			std::array<uint64_t, Bits> thresholds{};
+			long double bound = Bits == 64 ? 18446744073709551616.0L : static_cast<long double>(uint64_t{ 1 } << Bits);
+			for (auto& threshold : thresholds)
+			{
+				bound = bound * Probability::num / Probability::den;
+				threshold = bound >= 1.0L ? static_cast<uint64_t>(bound) : 0;
+			}
+			return thresholds;
+		}
 	}
 
-	inline size_t random_level(const size_t max_lvl, std::mt19937& gen) noexcept
+	class splitmix64 final
 	{
-		size_t lvl = 1;
-		while (impl::get_random_number<double>(impl::min, impl::max, gen) < impl::parameter && lvl < max_lvl)
+		uint64_t state;
+	public:
+		using result_type = uint64_t;
+
+		explicit splitmix64(const result_type seed = 0) noexcept : state(seed) {}
+
+		static constexpr result_type min() noexcept { return 0; }
+		static constexpr result_type max() noexcept { return UINT64_MAX; }
+
+		result_type operator()() noexcept
 		{
-			lvl++;
+			uint64_t value = (state += 0x9E3779B97F4A7C15ULL);
+			value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+			return value ^ (value >> 31);
 		}
-		return lvl;
-	}
+	};
+
+	class xorshift64 final
+	{
+		uint64_t state;
+	public:
+		using result_type = uint64_t;
+
+		explicit xorshift64(const result_type seed = 0) noexcept : state(seed != 0 ? seed : 0x9E3779B97F4A7C15ULL) {}
+
+		static constexpr result_type min() noexcept { return 0; }
+		static constexpr result_type max() noexcept { return UINT64_MAX; }
+
+		result_type operator()() noexcept
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			return state;
+		}
+	};
+
+	using promotion_half = std::ratio<1, 2>;
+	using promotion_quarter = std::ratio<1, 4>;
+	using promotion_inverse_e = std::ratio<367879441171, 1000000000000>;
+
+	template<typename Engine = splitmix64, typename Probability = promotion_half, typename Engine::result_type Seed = 5489U>
+		requires (Probability::num > 0 && Probability::num < Probability::den)
+	class level_generator final
+	{
+		static_assert(Engine::min() == 0 && (std::has_single_bit(static_cast<uint64_t>(Engine::max()) + 1U)
+			|| static_cast<uint64_t>(Engine::max()) == UINT64_MAX), "engine must produce full-width random words");
+
+		static constexpr unsigned word_bits = std::bit_width(static_cast<uint64_t>(Engine::max()));
+		static constexpr unsigned bits_per_level = std::countr_zero(static_cast<uintmax_t>(Probability::den));
+		static constexpr auto thresholds = impl::make_promotion_thresholds<Probability, word_bits>();
+
+		Engine engine{ Seed };
+
+	public:
+		using engine_type = Engine;
+		using probability = Probability;
+
+		level_generator() = default;
+		explicit level_generator(const typename Engine::result_type seed) : engine(seed) {}
+
+		size_t operator()(const size_t max_lvl) noexcept
+		{
+			const auto word = static_cast<uint64_t>(engine());
+			size_t lvl = 1;
+			if constexpr (impl::is_power_of_two_reciprocal<Probability>)
+			{
+				const unsigned zeros = word == 0 ? word_bits : static_cast<unsigned>(std::countr_zero(word));
+				lvl += zeros / bits_per_level;
+			}
+			else
+			{
+				while (lvl <= thresholds.size() && word < thresholds[lvl - 1])
+				{
+					++lvl;
+				}
+			}
+			return std::min(lvl, max_lvl);
+		}
+	};
 }
 
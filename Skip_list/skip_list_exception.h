@@ -5,7 +5,7 @@ class error_dereferencing_end : public std::exception
 {
 public:
 
-	char const* what() const override
+	char const* what() const noexcept override
 	{
 		return "dereference end";
 	}
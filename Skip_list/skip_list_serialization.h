@@ -0,0 +1,160 @@
+#pragma once
+#include <bit>
+#include <span>
+#include <array>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <concepts>
+#include <stdexcept>
+#include <type_traits>
+
+namespace skip_list_space
+{
+	class stream_writer final
+	{
+		std::ostream& out;
+
+	public:
+		explicit stream_writer(std::ostream& out_) noexcept : out(out_) {}
+
+		void write(const void* data, const size_t size)
+		{
+			out.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+			if (!out)
+			{
+				throw std::runtime_error("failed to write serialized skip list");
+			}
+		}
+	};
+
+	class stream_reader final
+	{
+		std::istream& in;
+
+	public:
+		explicit stream_reader(std::istream& in_) noexcept : in(in_) {}
+
+		void read(void* data, const size_t size)
+		{
+			in.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+			if (static_cast<size_t>(in.gcount()) != size)
+			{
+				throw std::runtime_error("serialized skip list is truncated");
+			}
+		}
+	};
+
+	class buffer_writer final
+	{
+		std::vector<std::byte>& buffer;
+
+	public:
+		explicit buffer_writer(std::vector<std::byte>& buffer_) noexcept : buffer(buffer_) {}
+
+		void write(const void* data, const size_t size)
+		{
+			const auto bytes = static_cast<const std::byte*>(data);
+			buffer.insert(buffer.end(), bytes, bytes + size);
+		}
+	};
+
+	class buffer_reader final
+	{
+		std::span<const std::byte> buffer;
+		size_t position = 0;
+
+	public:
+		explicit buffer_reader(const std::span<const std::byte> buffer_) noexcept : buffer(buffer_) {}
+
+		void read(void* data, const size_t size)
+		{
+			if (buffer.size() - position < size)
+			{
+				throw std::runtime_error("serialized skip list is truncated");
+			}
+			std::memcpy(data, buffer.data() + position, size);
+			position += size;
+		}
+
+		[[nodiscard]] size_t consumed() const noexcept { return position; }
+		[[nodiscard]] size_t remaining() const noexcept { return buffer.size() - position; }
+	};
+
+	template <typename T>
+	struct serializer;
+
+	template <typename T>
+		requires std::is_trivially_copyable_v<T>
+	struct serializer<T>
+	{
+		template <typename Writer>
+		static void write(Writer& out, const T& value)
+		{
+			out.write(&value, sizeof(T));
+		}
+
+		template <typename Reader>
+		static T read(Reader& in)
+		{
+			std::array<std::byte, sizeof(T)> bytes;
+			in.read(bytes.data(), bytes.size());
+			return std::bit_cast<T>(bytes);
+		}
+	};
+
+	template <typename Char, typename Traits, typename Alloc>
+		requires std::is_trivially_copyable_v<Char>
+	struct serializer<std::basic_string<Char, Traits, Alloc>>
+	{
+		static constexpr size_t read_chunk = 65536 / sizeof(Char);
+
+		template <typename Writer>
+		static void write(Writer& out, const std::basic_string<Char, Traits, Alloc>& value)
+		{
+			serializer<uint64_t>::write(out, static_cast<uint64_t>(value.size()));
+			out.write(value.data(), value.size() * sizeof(Char));
+		}
+
+		template <typename Reader>
+		static std::basic_string<Char, Traits, Alloc> read(Reader& in)
+		{
+			const auto size = serializer<uint64_t>::read(in);
+			std::basic_string<Char, Traits, Alloc> value;
+			if constexpr (requires { in.remaining(); })
+			{
+				if (size > in.remaining() / sizeof(Char))
+				{
+					throw std::runtime_error("serialized skip list is truncated");
+				}
+				value.resize(static_cast<size_t>(size));
+				in.read(value.data(), value.size() * sizeof(Char));
+			}
+			else
+			{
+				while (value.size() < size)
+				{
+					const size_t offset = value.size();
+					value.resize(offset + static_cast<size_t>(std::min<uint64_t>(size - offset, read_chunk)));
+					in.read(value.data() + offset, (value.size() - offset) * sizeof(Char));
+				}
+			}
+			return value;
+		}
+	};
+
+	template <typename T>
+	concept serializable = requires(const T& value, stream_writer& stream_out, buffer_writer& buffer_out,
+		stream_reader& stream_in, buffer_reader& buffer_in)
+	{
+		serializer<T>::write(stream_out, value);
+		serializer<T>::write(buffer_out, value);
+		{ serializer<T>::read(stream_in) } -> std::same_as<T>;
+		{ serializer<T>::read(buffer_in) } -> std::same_as<T>;
+	};
+}
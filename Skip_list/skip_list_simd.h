@@ -0,0 +1,162 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <concepts>
+#include <functional>
+#include <type_traits>
+#if !defined(SKIP_LIST_DISABLE_SIMD) && defined(__AVX2__)
+#define SKIP_LIST_SIMD_AVX2
+#include <immintrin.h>
+#elif !defined(SKIP_LIST_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SKIP_LIST_SIMD_SSE2
+#include <emmintrin.h>
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+#endif
+
+namespace skip_list_space
+{
+	enum class simd_instruction_set { scalar, sse2, avx2 };
+
+#if defined(SKIP_LIST_SIMD_AVX2)
+	inline constexpr simd_instruction_set key_search_instruction_set = simd_instruction_set::avx2;
+#elif defined(SKIP_LIST_SIMD_SSE2)
+	inline constexpr simd_instruction_set key_search_instruction_set = simd_instruction_set::sse2;
+#else
+	inline constexpr simd_instruction_set key_search_instruction_set = simd_instruction_set::scalar;
+#endif
+
+	template <typename Key>
+	concept simd_key = (std::integral<Key> || std::floating_point<Key>) && !std::same_as<Key, bool> && (sizeof(Key) == 4 || sizeof(Key) == 8);
+
+	template <typename Key, typename Compare>
+	concept simd_searchable = simd_key<Key> && (std::same_as<Compare, std::less<Key>> || std::same_as<Compare, std::less<>>);
+
+	namespace simd_detail
+	{
+		template <typename Key>
+		[[nodiscard]] size_t count_less_scalar(const Key* keys, const size_t count, const Key key) noexcept
+		{
+			size_t less = 0;
+			for (size_t index = 0; index < count; ++index)
+			{
+				less += keys[index] < key ? 1 : 0;
+			}
+			return less;
+		}
+
+		template <std::integral Key>
+		[[nodiscard]] std::make_signed_t<Key> signed_order(const Key key) noexcept
+		{
+			if constexpr (std::is_signed_v<Key>)
+			{
+				return key;
+			}
+			else
+			{
+				return static_cast<std::make_signed_t<Key>>(key ^ (Key{ 1 } << (sizeof(Key) * 8 - 1)));
+			}
+		}
+
+		template <typename Key>
+		[[nodiscard]] size_t count_less_vector(const Key* keys, const size_t count, const Key key, size_t& index) noexcept
+		{
+			size_t less = 0;
+#if defined(SKIP_LIST_SIMD_AVX2)
+			constexpr size_t lanes = 32 / sizeof(Key);
+			if constexpr (std::same_as<Key, float>)
+			{
+				const __m256 probe = _mm256_set1_ps(key);
+				for (; index + lanes <= count; index += lanes)
+				{
+					less += std::popcount(static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(keys + index), probe, _CMP_LT_OQ))));
+				}
+			}
+			else if constexpr (std::same_as<Key, double>)
+			{
+				const __m256d probe = _mm256_set1_pd(key);
+				for (; index + lanes <= count; index += lanes)
+				{
+					less += std::popcount(static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(keys + index), probe, _CMP_LT_OQ))));
+				}
+			}
+			else if constexpr (sizeof(Key) == 4)
+			{
+				const __m256i probe = _mm256_set1_epi32(signed_order(key));
+				const __m256i bias = _mm256_set1_epi32(std::is_signed_v<Key> ? 0 : INT32_MIN);
+				for (; index + lanes <= count; index += lanes)
+				{
+					const __m256i block = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + index)), bias);
+					less += std::popcount(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(probe, block)))));
+				}
+			}
+			else
+			{
+				const __m256i probe = _mm256_set1_epi64x(signed_order(key));
+				const __m256i bias = _mm256_set1_epi64x(std::is_signed_v<Key> ? 0 : INT64_MIN);
+				for (; index + lanes <= count; index += lanes)
+				{
+					const __m256i block = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + index)), bias);
+					less += std::popcount(static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(probe, block)))));
+				}
+			}
+#elif defined(SKIP_LIST_SIMD_SSE2)
+			constexpr size_t lanes = 16 / sizeof(Key);
+			if constexpr (std::same_as<Key, float>)
+			{
+				const __m128 probe = _mm_set1_ps(key);
+				for (; index + lanes <= count; index += lanes)
+				{
+					less += std::popcount(static_cast<unsigned>(_mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(keys + index), probe))));
+				}
+			}
+			else if constexpr (std::same_as<Key, double>)
+			{
+				const __m128d probe = _mm_set1_pd(key);
+				for (; index + lanes <= count; index += lanes)
+				{
+					less += std::popcount(static_cast<unsigned>(_mm_movemask_pd(_mm_cmplt_pd(_mm_loadu_pd(keys + index), probe))));
+				}
+			}
+			else if constexpr (sizeof(Key) == 4)
+			{
+				const __m128i probe = _mm_set1_epi32(signed_order(key));
+				const __m128i bias = _mm_set1_epi32(std::is_signed_v<Key> ? 0 : INT32_MIN);
+				for (; index + lanes <= count; index += lanes)
+				{
+					const __m128i block = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + index)), bias);
+					less += std::popcount(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(probe, block)))));
+				}
+			}
+#if defined(__SSE4_2__)
+			else
+			{
+				const __m128i probe = _mm_set1_epi64x(signed_order(key));
+				const __m128i bias = _mm_set1_epi64x(std::is_signed_v<Key> ? 0 : INT64_MIN);
+				for (; index + lanes <= count; index += lanes)
+				{
+					const __m128i block = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + index)), bias);
+					less += std::popcount(static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(probe, block)))));
+				}
+			}
+#endif
+#else
+			static_cast<void>(keys);
+			static_cast<void>(count);
+			static_cast<void>(key);
+			static_cast<void>(index);
+#endif
+			return less;
+		}
+	}
+
+	template <simd_key Key>
+	[[nodiscard]] size_t count_less_keys(const Key* keys, const size_t count, const Key key) noexcept
+	{
+		size_t index = 0;
+		const size_t less = simd_detail::count_less_vector(keys, count, key, index);
+		return less + simd_detail::count_less_scalar(keys + index, count - index, key);
+	}
+}
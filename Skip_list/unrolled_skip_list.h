@@ -0,0 +1,620 @@
+#pragma once
+#include <array>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include "Skip_list.h"
+#include "skip_list_simd.h"
+
+namespace skip_list_space
+{
+	template <typename Key, typename Value>
+	[[nodiscard]] constexpr size_t default_node_capacity() noexcept
+	{
+		constexpr size_t node_bytes = 4 * 64;
+		return std::clamp<size_t>(node_bytes / (sizeof(Key) + sizeof(Value)), 4, 64);
+	}
+
+	template <typename Key, typename Value, size_t Capacity>
+	class unrolled_node final
+	{
+		static_assert(Capacity >= 4 && Capacity <= UINT32_MAX, "node capacity must be at least 4 entries");
+
+		template <typename T>
+		union slots
+		{
+			slots() noexcept {}
+			~slots() {}
+			T items[Capacity];
+		};
+
+		slots<Key> keys;
+		slots<Value> values;
+		uint32_t count = 0;
+		uint32_t level;
+
+		[[nodiscard]] static constexpr size_t links_offset() noexcept
+		{
+			return (sizeof(unrolled_node) + alignof(unrolled_node*) - 1) / alignof(unrolled_node*) * alignof(unrolled_node*);
+		}
+
+		[[nodiscard]] unrolled_node** links() noexcept
+		{
+			return reinterpret_cast<unrolled_node**>(reinterpret_cast<std::byte*>(this) + links_offset());
+		}
+
+		[[nodiscard]] unrolled_node* const* links() const noexcept
+		{
+			return reinterpret_cast<unrolled_node* const*>(reinterpret_cast<const std::byte*>(this) + links_offset());
+		}
+
+		explicit unrolled_node(const size_t level_) noexcept : level(static_cast<uint32_t>(level_))
+		{
+			std::uninitialized_fill_n(links(), level_, nullptr);
+		}
+
+		~unrolled_node()
+		{
+			std::destroy_n(keys.items, count);
+			std::destroy_n(values.items, count);
+		}
+
+	public:
+		unrolled_node(const unrolled_node&) = delete;
+		unrolled_node& operator=(const unrolled_node&) = delete;
+
+		[[nodiscard]] static constexpr size_t allocation_size(const size_t level_) noexcept
+		{
+			return links_offset() + level_ * sizeof(unrolled_node*);
+		}
+
+		template <typename Pool>
+		static unrolled_node* create(Pool& pool, const size_t level_)
+		{
+			return ::new(pool.allocate(level_)) unrolled_node(level_);
+		}
+
+		template <typename Pool>
+		static void destroy(Pool& pool, unrolled_node* del_node) noexcept
+		{
+			const size_t level_ = del_node->level;
+			del_node->~unrolled_node();
+			pool.deallocate(del_node, level_);
+		}
+
+		[[nodiscard]] unrolled_node* get_right_node(const size_t lvl_index) const noexcept { return links()[lvl_index]; }
+		void set_right_node(const size_t lvl_index, unrolled_node* node) noexcept { links()[lvl_index] = node; }
+		[[nodiscard]] size_t get_level() const noexcept { return level; }
+
+		[[nodiscard]] const Key& get_key() const noexcept { return keys.items[0]; }
+		[[nodiscard]] const Key& key(const size_t position) const noexcept { return keys.items[position]; }
+		[[nodiscard]] const Key* key_data() const noexcept { return keys.items; }
+		[[nodiscard]] Value& value(const size_t position) noexcept { return values.items[position]; }
+		[[nodiscard]] const Value& value(const size_t position) const noexcept { return values.items[position]; }
+
+		[[nodiscard]] size_t size() const noexcept { return count; }
+		[[nodiscard]] bool empty() const noexcept { return count == 0; }
+		[[nodiscard]] bool full() const noexcept { return count == Capacity; }
+
+		void emplace(const size_t position, Key&& key_, Value&& value_) noexcept
+		{
+			if (position == count)
+			{
+				std::construct_at(keys.items + count, std::move(key_));
+				std::construct_at(values.items + count, std::move(value_));
+			}
+			else
+			{
+				std::construct_at(keys.items + count, std::move(keys.items[count - 1]));
+				std::construct_at(values.items + count, std::move(values.items[count - 1]));
+				std::move_backward(keys.items + position, keys.items + count - 1, keys.items + count);
+				std::move_backward(values.items + position, values.items + count - 1, values.items + count);
+				keys.items[position] = std::move(key_);
+				values.items[position] = std::move(value_);
+			}
+			++count;
+		}
+
+		void erase(const size_t position) noexcept
+		{
+			std::move(keys.items + position + 1, keys.items + count, keys.items + position);
+			std::move(values.items + position + 1, values.items + count, values.items + position);
+			--count;
+			std::destroy_at(keys.items + count);
+			std::destroy_at(values.items + count);
+		}
+
+		void move_tail_to(unrolled_node& other, const size_t first) noexcept
+		{
+			std::uninitialized_move(keys.items + first, keys.items + count, other.keys.items + other.count);
+			std::uninitialized_move(values.items + first, values.items + count, other.values.items + other.count);
+			other.count += static_cast<uint32_t>(count - first);
+			std::destroy(keys.items + first, keys.items + count);
+			std::destroy(values.items + first, values.items + count);
+			count = static_cast<uint32_t>(first);
+		}
+
+		void move_head_to(unrolled_node& other, const size_t moved) noexcept
+		{
+			std::uninitialized_move(keys.items, keys.items + moved, other.keys.items + other.count);
+			std::uninitialized_move(values.items, values.items + moved, other.values.items + other.count);
+			other.count += static_cast<uint32_t>(moved);
+			std::move(keys.items + moved, keys.items + count, keys.items);
+			std::move(values.items + moved, values.items + count, values.items);
+			std::destroy(keys.items + count - moved, keys.items + count);
+			std::destroy(values.items + count - moved, values.items + count);
+			count -= static_cast<uint32_t>(moved);
+		}
+	};
+
+	template <typename Key,
+		typename Value,
+		typename Compare = std::less<Key>,
+		size_t Max_level = default_max_level,
+		size_t Node_capacity = default_node_capacity<Key, Value>(),
+		typename Alloc = std::allocator<std::pair<const Key, Value>>,
+		level_generator_policy Level_generator = random_tools::level_generator<>>
+		requires is_compare<Compare, Key> &&
+			std::is_nothrow_move_constructible_v<Key> && std::is_nothrow_move_assignable_v<Key> &&
+			std::is_nothrow_move_constructible_v<Value> && std::is_nothrow_move_assignable_v<Value>
+	class unrolled_skip_list final
+	{
+		using node = unrolled_node<Key, Value, Node_capacity>;
+		using past_nodes = std::array<node*, Max_level>;
+
+		node* head = nullptr;
+		Compare compare;
+		node_pool<node, Alloc, Max_level> pool;
+		size_t list_size = 0;
+		size_t nodes = 0;
+		size_t list_lvl = 0;
+		Level_generator level_generator{};
+
+		static constexpr size_t min_fill = Node_capacity / 4;
+		static constexpr size_t merge_fill = Node_capacity * 3 / 4;
+
+		[[nodiscard]] node* search_key_storing_past_elements(const Key& key, past_nodes& updated_nods) const
+		{
+			std::fill(updated_nods.begin() + static_cast<std::ptrdiff_t>(list_lvl), updated_nods.end(), head);
+			auto current = head;
+			for (int lvl_index = static_cast<int>(list_lvl) - 1; lvl_index >= 0; --lvl_index)
+			{
+				current = next_less_key_element(current, lvl_index, key, static_cast<const node*>(nullptr), compare);
+				updated_nods[lvl_index] = current;
+			}
+			return current;
+		}
+
+		[[nodiscard]] size_t lower_bound_in_node(const node* current, const Key& key) const
+		{
+			if constexpr (simd_searchable<Key, Compare>)
+			{
+				return count_less_keys(current->key_data(), current->size(), key);
+			}
+			else
+			{
+				return static_cast<size_t>(std::lower_bound(current->key_data(), current->key_data() + current->size(), key, compare) - current->key_data());
+			}
+		}
+
+		[[nodiscard]] std::pair<node*, size_t> search_lower_bound(const Key& key) const
+		{
+			if (head == nullptr)
+			{
+				return { nullptr, 0 };
+			}
+			auto current = head;
+			for (int lvl_index = static_cast<int>(list_lvl) - 1; lvl_index >= 0; --lvl_index)
+			{
+				current = next_less_key_element(current, lvl_index, key, static_cast<const node*>(nullptr), compare);
+			}
+			if (current != head)
+			{
+				if (const size_t position = lower_bound_in_node(current, key); position < current->size())
+				{
+					return { current, position };
+				}
+			}
+			return { current->get_right_node(0), 0 };
+		}
+
+		void link_node(node* new_node, node* left_node, const past_nodes& updated_nods) noexcept
+		{
+			for (size_t lvl_index = 0; lvl_index < new_node->get_level(); ++lvl_index)
+			{
+				auto previous = lvl_index < left_node->get_level() ? left_node : updated_nods[lvl_index];
+				new_node->set_right_node(lvl_index, previous->get_right_node(lvl_index));
+				previous->set_right_node(lvl_index, new_node);
+			}
+			list_lvl = (std::max)(list_lvl, new_node->get_level());
+			++nodes;
+		}
+
+		void unlink_node(node* old_node, node* left_node, const past_nodes& updated_nods) noexcept
+		{
+			for (size_t lvl_index = 0; lvl_index < old_node->get_level(); ++lvl_index)
+			{
+				auto previous = lvl_index < left_node->get_level() ? left_node : updated_nods[lvl_index];
+				previous->set_right_node(lvl_index, old_node->get_right_node(lvl_index));
+			}
+			node::destroy(pool, old_node);
+			--nodes;
+			while (list_lvl > 0 && head->get_right_node(list_lvl - 1) == nullptr)
+			{
+				--list_lvl;
+			}
+		}
+
+		void rebalance(node* target, const past_nodes& updated_nods) noexcept
+		{
+			auto next_node = target->get_right_node(0);
+			if (next_node == nullptr)
+			{
+				return;
+			}
+			if (target->size() + next_node->size() <= merge_fill)
+			{
+				next_node->move_tail_to(*target, 0);
+				unlink_node(next_node, target, updated_nods);
+			}
+			else
+			{
+				next_node->move_head_to(*target, (next_node->size() - target->size()) / 2);
+			}
+		}
+
+		template <typename K, typename V>
+		std::pair<node*, size_t> emplace_unique(K&& key, V&& value)
+		{
+			if (head == nullptr)
+			{
+				head = node::create(pool, Max_level);
+			}
+			past_nodes updated_nods;
+			auto previous = search_key_storing_past_elements(key, updated_nods);
+			auto target = previous->get_right_node(0);
+			size_t position = 0;
+			if (target != nullptr && !compare(key, target->get_key()))
+			{
+				return { target, 0 };
+			}
+			if (previous != head)
+			{
+				target = previous;
+				position = lower_bound_in_node(target, key);
+				if (position < target->size() && !compare(key, target->key(position)))
+				{
+					return { target, position };
+				}
+			}
+			Key new_key(std::forward<K>(key));
+			Value new_value(std::forward<V>(value));
+			if (target == nullptr)
+			{
+				target = node::create(pool, std::clamp<size_t>(level_generator(Max_level), 1, Max_level));
+				link_node(target, head, updated_nods);
+			}
+			else if (target->full())
+			{
+				const size_t split = position == Node_capacity && target->get_right_node(0) == nullptr ? Node_capacity : Node_capacity / 2;
+				auto new_node = node::create(pool, std::clamp<size_t>(level_generator(Max_level), 1, Max_level));
+				target->move_tail_to(*new_node, split);
+				link_node(new_node, target, updated_nods);
+				if (position >= split)
+				{
+					target = new_node;
+					position -= split;
+				}
+			}
+			target->emplace(position, std::move(new_key), std::move(new_value));
+			++list_size;
+			return { target, position };
+		}
+
+		void copy_nodes(const unrolled_skip_list& another)
+		{
+			if (another.empty())
+			{
+				return;
+			}
+			head = node::create(pool, Max_level);
+			past_nodes last_nodes;
+			last_nodes.fill(head);
+			for (auto source = another.head->get_right_node(0); source != nullptr; source = source->get_right_node(0))
+			{
+				auto new_node = node::create(pool, std::clamp<size_t>(level_generator(Max_level), 1, Max_level));
+				link_node(new_node, last_nodes[0], last_nodes);
+				std::fill_n(last_nodes.begin(), new_node->get_level(), new_node);
+				for (size_t position = 0; position < source->size(); ++position)
+				{
+					new_node->emplace(position, Key(source->key(position)), Value(source->value(position)));
+					++list_size;
+				}
+			}
+		}
+
+		void release_nodes() noexcept
+		{
+			if (head == nullptr)
+			{
+				return;
+			}
+			for (auto current = head->get_right_node(0); current != nullptr;)
+			{
+				auto next_node = current->get_right_node(0);
+				node::destroy(pool, current);
+				current = next_node;
+			}
+			node::destroy(pool, head);
+			head = nullptr;
+			list_size = 0;
+			nodes = 0;
+			list_lvl = 0;
+		}
+
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using size_type = std::size_t;
+		using key_compare = Compare;
+		using allocator_type = Alloc;
+
+		static constexpr size_t node_capacity = Node_capacity;
+
+		template <bool IsConst>
+		class list_iterator final
+		{
+			using node_pointer = std::conditional_t<IsConst, const node*, node*>;
+
+			node_pointer current = nullptr;
+			size_t position = 0;
+
+			friend class list_iterator<!IsConst>;
+
+		public:
+			using value_type = std::pair<const Key&, std::conditional_t<IsConst, const Value&, Value&>>;
+			using reference = value_type;
+			using difference_type = std::ptrdiff_t;
+			using iterator_category = std::forward_iterator_tag;
+
+			list_iterator() = default;
+			list_iterator(node_pointer current_, const size_t position_) noexcept : current(current_), position(position_) {}
+
+			template<bool Other_Const>
+				requires (!Other_Const || IsConst)
+			list_iterator(const list_iterator<Other_Const>& other) noexcept : current(other.current), position(other.position) {}
+
+			reference operator*() const
+			{
+				if (current == nullptr)
+				{
+					throw error_dereferencing_end();
+				}
+				return reference(current->key(position), current->value(position));
+			}
+
+			list_iterator& operator++()
+			{
+				if (current == nullptr)
+				{
+					throw std::out_of_range("out of range");
+				}
+				if (++position == current->size())
+				{
+					current = current->get_right_node(0);
+					position = 0;
+				}
+				return *this;
+			}
+
+			list_iterator operator++(int)
+			{
+				auto previous = *this;
+				++*this;
+				return previous;
+			}
+
+			bool operator==(const list_iterator& other) const noexcept { return current == other.current && position == other.position; }
+			bool operator!=(const list_iterator& other) const noexcept { return !(*this == other); }
+		};
+
+		using iterator = list_iterator<false>;
+		using const_iterator = list_iterator<true>;
+
+		explicit unrolled_skip_list(const Compare& comp = Compare(), const Alloc& alloc = Alloc()) : compare(comp), pool(alloc) {}
+
+		unrolled_skip_list(const unrolled_skip_list& another) : compare(another.compare),
+			pool(std::allocator_traits<Alloc>::select_on_container_copy_construction(another.pool.get_allocator()))
+		{
+			try
+			{
+				copy_nodes(another);
+			}
+			catch (...)
+			{
+				release_nodes();
+				throw;
+			}
+		}
+
+		unrolled_skip_list(unrolled_skip_list&& another) noexcept : head(std::exchange(another.head, nullptr)),
+			compare(std::move_if_noexcept(another.compare)), pool(std::move(another.pool)),
+			list_size(std::exchange(another.list_size, 0)), nodes(std::exchange(another.nodes, 0)),
+			list_lvl(std::exchange(another.list_lvl, 0)) {}
+
+		unrolled_skip_list& operator=(const unrolled_skip_list& another)
+		{
+			if (this != &another)
+			{
+				unrolled_skip_list copy(another);
+				swap(copy);
+			}
+			return *this;
+		}
+
+		unrolled_skip_list& operator=(unrolled_skip_list&& another) noexcept
+		{
+			if (this != &another)
+			{
+				release_nodes();
+				swap(another);
+			}
+			return *this;
+		}
+
+		~unrolled_skip_list()
+		{
+			release_nodes();
+		}
+
+		template <class Pair>
+			requires std::is_convertible_v<std::pair<Key, Value>, std::remove_cvref_t<Pair>>
+		std::pair<iterator, bool> insert(Pair&& value)
+		{
+			const size_t old_size = list_size;
+			auto [target, position] = emplace_unique(std::forward<Pair>(value).first, std::forward<Pair>(value).second);
+			return { iterator(target, position), list_size != old_size };
+		}
+
+		template <typename V>
+		std::pair<iterator, bool> insert_or_assign(const Key& key, V&& value)
+		{
+			const size_t old_size = list_size;
+			auto [target, position] = emplace_unique(key, value);
+			if (list_size == old_size)
+			{
+				target->value(position) = std::forward<V>(value);
+			}
+			return { iterator(target, position), list_size != old_size };
+		}
+
+		Value& operator[](const Key& key)
+			requires std::is_default_constructible_v<Value>
+		{
+			auto [target, position] = search_lower_bound(key);
+			if (target == nullptr || compare(key, target->key(position)))
+			{
+				std::tie(target, position) = emplace_unique(key, Value{});
+			}
+			return target->value(position);
+		}
+
+		[[nodiscard]] const Value& at(const Key& key) const
+		{
+			auto [target, position] = search_lower_bound(key);
+			if (target == nullptr || compare(key, target->key(position)))
+			{
+				throw std::out_of_range("Out of range!");
+			}
+			return target->value(position);
+		}
+
+		Value& at(const Key& key)
+		{
+			return const_cast<Value&>(std::as_const(*this).at(key));
+		}
+
+		bool erase(const Key& key)
+		{
+			if (head == nullptr)
+			{
+				return false;
+			}
+			past_nodes updated_nods;
+			auto previous = search_key_storing_past_elements(key, updated_nods);
+			auto target = previous->get_right_node(0);
+			size_t position = 0;
+			if (target == nullptr || compare(key, target->get_key()))
+			{
+				if (previous == head)
+				{
+					return false;
+				}
+				target = previous;
+				position = lower_bound_in_node(target, key);
+				if (position == target->size() || compare(key, target->key(position)))
+				{
+					return false;
+				}
+			}
+			target->erase(position);
+			--list_size;
+			if (target->empty())
+			{
+				unlink_node(target, previous, updated_nods);
+			}
+			else if (target->size() < min_fill)
+			{
+				rebalance(target, updated_nods);
+			}
+			return true;
+		}
+
+		void clear() noexcept
+		{
+			release_nodes();
+		}
+
+		void swap(unrolled_skip_list& another) noexcept
+		{
+			std::swap(head, another.head);
+			std::swap(compare, another.compare);
+			pool.swap(another.pool);
+			std::swap(list_size, another.list_size);
+			std::swap(nodes, another.nodes);
+			std::swap(list_lvl, another.list_lvl);
+		}
+
+		[[nodiscard]] const_iterator find(const Key& key) const
+		{
+			auto [target, position] = search_lower_bound(key);
+			return target != nullptr && !compare(key, target->key(position)) ? const_iterator(target, position) : end();
+		}
+
+		[[nodiscard]] iterator find(const Key& key)
+		{
+			auto [target, position] = search_lower_bound(key);
+			return target != nullptr && !compare(key, target->key(position)) ? iterator(target, position) : end();
+		}
+
+		[[nodiscard]] bool contains(const Key& key) const
+		{
+			auto [target, position] = search_lower_bound(key);
+			return target != nullptr && !compare(key, target->key(position));
+		}
+
+		[[nodiscard]] const_iterator lower_bound(const Key& key) const
+		{
+			auto [target, position] = search_lower_bound(key);
+			return const_iterator(target, position);
+		}
+
+		[[nodiscard]] iterator lower_bound(const Key& key)
+		{
+			auto [target, position] = search_lower_bound(key);
+			return iterator(target, position);
+		}
+
+		[[nodiscard]] iterator begin() noexcept { return iterator(head == nullptr ? nullptr : head->get_right_node(0), 0); }
+		[[nodiscard]] iterator end() noexcept { return iterator(); }
+		[[nodiscard]] const_iterator begin() const noexcept { return cbegin(); }
+		[[nodiscard]] const_iterator end() const noexcept { return cend(); }
+		[[nodiscard]] const_iterator cbegin() const noexcept { return const_iterator(head == nullptr ? nullptr : head->get_right_node(0), 0); }
+		[[nodiscard]] const_iterator cend() const noexcept { return const_iterator(); }
+
+		[[nodiscard]] size_type size() const noexcept { return list_size; }
+		[[nodiscard]] bool empty() const noexcept { return list_size == 0; }
+		[[nodiscard]] size_type node_count() const noexcept { return nodes; }
+		[[nodiscard]] Alloc get_allocator() const { return pool.get_allocator(); }
+
+		void shrink_to_fit() noexcept
+		{
+			pool.release();
+		}
+	};
+}
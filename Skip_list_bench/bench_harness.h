@@ -0,0 +1,163 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <algorithm>
+#include <string_view>
+#include "random_number.h"
+
+namespace skip_list_bench
+{
+	template<typename T>
+	void do_not_optimize(const T& value)
+	{
+#if defined(__GNUC__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &value;
+#endif
+	}
+
+	struct bench_options
+	{
+		std::vector<size_t> sizes{ 1000, 100000, 1000000 };
+		size_t repetitions = 3;
+		std::string filter;
+	};
+
+	[[nodiscard]] inline std::vector<size_t> parse_sizes(std::string_view text)
+	{
+		std::vector<size_t> sizes;
+		while (!text.empty())
+		{
+			const auto comma = text.find(',');
+			const std::string item(text.substr(0, comma));
+			char* suffix = nullptr;
+			auto size = static_cast<size_t>(std::strtoull(item.c_str(), &suffix, 10));
+			if (*suffix == 'K' || *suffix == 'k')
+			{
+				size *= 1000;
+			}
+			else if (*suffix == 'M' || *suffix == 'm')
+			{
+				size *= 1000000;
+			}
+			if (size != 0)
+			{
+				sizes.push_back(size);
+			}
+			text = comma == std::string_view::npos ? std::string_view() : text.substr(comma + 1);
+		}
+		return sizes;
+	}
+
+	[[nodiscard]] inline bench_options parse_options(const int argc, char** argv)
+	{
+		bench_options options;
+		for (int index = 1; index < argc; ++index)
+		{
+			const std::string_view argument(argv[index]);
+			if (argument.starts_with("--sizes="))
+			{
+				options.sizes = parse_sizes(argument.substr(8));
+			}
+			else if (argument.starts_with("--repetitions="))
+			{
+				options.repetitions = std::max<size_t>(1, std::strtoull(argv[index] + 14, nullptr, 10));
+			}
+			else if (argument.starts_with("--filter="))
+			{
+				options.filter = std::string(argument.substr(9));
+			}
+			else
+			{
+				std::fprintf(stderr, "usage: %s [--sizes=1K,100K,1M] [--repetitions=N] [--filter=text]\n       %s workload --help\n", argv[0], argv[0]);
+				std::exit(2);
+			}
+		}
+		return options;
+	}
+
+	template<typename Prepare, typename Run>
+	[[nodiscard]] double best_ns_per_op(const size_t repetitions, const size_t operations, Prepare&& prepare, Run&& run)
+	{
+		double best = 0;
+		for (size_t repetition = 0; repetition < repetitions; ++repetition)
+		{
+			auto state = prepare();
+			const auto start = std::chrono::steady_clock::now();
+			run(state);
+			const auto stop = std::chrono::steady_clock::now();
+			do_not_optimize(state);
+			const double elapsed = std::chrono::duration<double, std::nano>(stop - start).count() / static_cast<double>(std::max<size_t>(operations, 1));
+			best = repetition == 0 ? elapsed : std::min(best, elapsed);
+		}
+		return best;
+	}
+
+	inline void print_header()
+	{
+		std::printf("%-28s %-12s %10s %-12s %12s\n", "container", "key", "size", "operation", "ns/op");
+	}
+
+	inline void print_row(const std::string& container, const char* key_name, const size_t size, const char* operation, const double ns_per_op)
+	{
+		std::printf("%-28s %-12s %10zu %-12s %12.1f\n", container.c_str(), key_name, size, operation, ns_per_op);
+		std::fflush(stdout);
+	}
+
+	[[nodiscard]] inline uint64_t scramble(const uint64_t index) noexcept
+	{
+		return index * 0x9E3779B97F4A7C15ULL;
+	}
+
+	template<typename Key>
+	struct key_maker;
+
+	template<>
+	struct key_maker<int>
+	{
+		static constexpr const char* name = "int";
+		[[nodiscard]] static int make(const uint64_t index) { return static_cast<int>(static_cast<uint32_t>(index * 2654435761U)); }
+	};
+
+	template<>
+	struct key_maker<std::string>
+	{
+		static constexpr const char* name = "string";
+		[[nodiscard]] static std::string make(const uint64_t index)
+		{
+			char buffer[24];
+			std::snprintf(buffer, sizeof(buffer), "key%016llx", static_cast<unsigned long long>(scramble(index)));
+			return buffer;
+		}
+	};
+
+	template<typename Key>
+	[[nodiscard]] std::vector<Key> make_keys(const size_t size, const uint64_t first_index = 0)
+	{
+		std::vector<Key> keys;
+		keys.reserve(size);
+		for (size_t index = 0; index < size; ++index)
+		{
+			keys.push_back(key_maker<Key>::make(first_index + index));
+		}
+		return keys;
+	}
+
+	template<typename Key>
+	[[nodiscard]] std::vector<Key> shuffled(std::vector<Key> keys, const uint64_t seed)
+	{
+		random_tools::splitmix64 engine(seed);
+		for (size_t index = keys.size(); index > 1; --index)
+		{
+			std::swap(keys[index - 1], keys[engine() % index]);
+		}
+		return keys;
+	}
+}
@@ -0,0 +1,211 @@
+// Builds without the Visual Studio solution as well:
+//   g++ -std=c++20 -O2 -DNDEBUG -pthread -ISkip_list -ISkip_list_test Skip_list_bench/*.cpp -o skip_list_bench
+//   ./skip_list_bench --sizes=1K,1M,50M --repetitions=3 --filter=skip_list<32>/int
+//   ./skip_list_bench workload --workload=A --distribution=zipfian --threads=8 --target=sharded
+// Add -mavx2 (/arch:AVX2) to select the AVX2 key search in unrolled_skip_list nodes; SSE2 is the x86-64 default.
+// The sorted vector baseline inserts and erases in batches (sort/unique and compaction),
+// which is how it would be used in practice; per-element shifting would be quadratic.
+#include <map>
+#include <cstring>
+#include <optional>
+#include "Skip_list.h"
+#include "unrolled_skip_list.h"
+#include "user_class.h"
+#include "bench_harness.h"
+#include "workload.h"
+
+namespace skip_list_bench
+{
+	template<>
+	struct key_maker<user_class<int>>
+	{
+		static constexpr const char* name = "user_class";
+		[[nodiscard]] static user_class<int> make(const uint64_t index) { return user_class<int>(key_maker<int>::make(index)); }
+	};
+
+	template<typename Key, typename Value>
+	class sorted_vector final
+	{
+		std::vector<std::pair<Key, Value>> entries;
+
+		static bool key_less(const std::pair<Key, Value>& entry, const Key& key) { return entry.first < key; }
+
+	public:
+		void insert_all(const std::vector<Key>& keys)
+		{
+			entries.reserve(entries.size() + keys.size());
+			for (const auto& key : keys)
+			{
+				entries.emplace_back(key, Value{});
+			}
+			std::stable_sort(entries.begin(), entries.end(), [](const auto& first, const auto& second) { return first.first < second.first; });
+			entries.erase(std::unique(entries.begin(), entries.end(), [](const auto& first, const auto& second) { return first.first == second.first; }), entries.end());
+		}
+
+		void erase_all(std::vector<Key> keys)
+		{
+			std::sort(keys.begin(), keys.end());
+			entries.erase(std::remove_if(entries.begin(), entries.end(),
+				[&keys](const auto& entry) { return std::binary_search(keys.begin(), keys.end(), entry.first); }), entries.end());
+		}
+
+		[[nodiscard]] bool contains(const Key& key) const
+		{
+			auto position = std::lower_bound(entries.begin(), entries.end(), key, key_less);
+			return position != entries.end() && position->first == key;
+		}
+
+		Value& operator[](const Key& key)
+		{
+			auto position = std::lower_bound(entries.begin(), entries.end(), key, key_less);
+			if (position == entries.end() || !(position->first == key))
+			{
+				position = entries.emplace(position, key, Value{});
+			}
+			return position->second;
+		}
+
+		void clear() noexcept { entries.clear(); }
+		[[nodiscard]] auto begin() const { return entries.begin(); }
+		[[nodiscard]] auto end() const { return entries.end(); }
+	};
+
+	template<typename Container, typename Key>
+	void insert_all(Container& container, const std::vector<Key>& keys)
+	{
+		if constexpr (requires { container.insert_all(keys); })
+		{
+			container.insert_all(keys);
+		}
+		else
+		{
+			for (const auto& key : keys)
+			{
+				container.insert(std::pair<Key, int>(key, 0));
+			}
+		}
+	}
+
+	template<typename Container, typename Key>
+	void erase_all(Container& container, const std::vector<Key>& keys)
+	{
+		if constexpr (requires { container.erase_all(keys); })
+		{
+			container.erase_all(keys);
+		}
+		else
+		{
+			for (const auto& key : keys)
+			{
+				container.erase(key);
+			}
+		}
+	}
+
+	template<typename Container, typename Key>
+	[[nodiscard]] bool contains(const Container& container, const Key& key)
+	{
+		if constexpr (requires { container.contains(key); })
+		{
+			return container.contains(key);
+		}
+		else
+		{
+			return container.find(key) != container.end();
+		}
+	}
+
+	template<typename Container, typename Key>
+	void run_suite(const std::string& name, const bench_options& options)
+	{
+		const char* key_name = key_maker<Key>::name;
+		if (!options.filter.empty() && (name + "/" + key_name).find(options.filter) == std::string::npos)
+		{
+			return;
+		}
+		for (const size_t size : options.sizes)
+		{
+			const auto keys = make_keys<Key>(size);
+			const auto lookups = shuffled(keys, size);
+			const std::vector<Key> erased(lookups.begin(), lookups.begin() + static_cast<std::ptrdiff_t>(size / 2));
+			const auto repetitions = options.repetitions;
+
+			print_row(name, key_name, size, "insert", best_ns_per_op(repetitions, size,
+				[] { return Container(); },
+				[&](Container& container) { insert_all(container, lookups); }));
+
+			Container built;
+			insert_all(built, lookups);
+
+			print_row(name, key_name, size, "find", best_ns_per_op(repetitions, size,
+				[] { return size_t{ 0 }; },
+				[&](size_t& hits)
+				{
+					for (const auto& key : lookups)
+					{
+						hits += contains(built, key) ? 1 : 0;
+					}
+				}));
+
+			print_row(name, key_name, size, "operator[]", best_ns_per_op(repetitions, size,
+				[] { return 0; },
+				[&](int& sum)
+				{
+					for (const auto& key : lookups)
+					{
+						sum += built[key];
+					}
+				}));
+
+			print_row(name, key_name, size, "iterate", best_ns_per_op(repetitions, size,
+				[] { return size_t{ 0 }; },
+				[&](size_t& visited)
+				{
+					for (const auto& entry : std::as_const(built))
+					{
+						do_not_optimize(entry);
+						++visited;
+					}
+				}));
+
+			print_row(name, key_name, size, "copy", best_ns_per_op(repetitions, size,
+				[] { return std::optional<Container>(); },
+				[&](std::optional<Container>& copy) { copy.emplace(built); }));
+
+			print_row(name, key_name, size, "erase", best_ns_per_op(repetitions, erased.size(),
+				[&] { return Container(built); },
+				[&](Container& container) { erase_all(container, erased); }));
+
+			print_row(name, key_name, size, "clear", best_ns_per_op(repetitions, size,
+				[&] { return Container(built); },
+				[](Container& container) { container.clear(); }));
+		}
+	}
+
+	template<typename Key>
+	void run_key_type(const bench_options& options)
+	{
+		using seeded_generator = random_tools::level_generator<random_tools::splitmix64, random_tools::promotion_half, 42>;
+		run_suite<skip_list_space::skip_list<Key, int>, Key>("skip_list<32>", options);
+		run_suite<skip_list_space::skip_list<Key, int, std::less<Key>, 16>, Key>("skip_list<16>", options);
+		run_suite<skip_list_space::skip_list<Key, int, std::less<Key>, 32, std::allocator<std::pair<const Key, int>>, seeded_generator>, Key>(
+			"skip_list<32,seed=42>", options);
+		run_suite<skip_list_space::unrolled_skip_list<Key, int>, Key>("unrolled_skip_list", options);
+		run_suite<std::map<Key, int>, Key>("std::map", options);
+		run_suite<sorted_vector<Key, int>, Key>("sorted_vector", options);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc > 1 && std::string_view(argv[1]) == "workload")
+	{
+		return skip_list_bench::run_workload(argc - 1, argv + 1);
+	}
+	const auto options = skip_list_bench::parse_options(argc, argv);
+	skip_list_bench::print_header();
+	skip_list_bench::run_key_type<int>(options);
+	skip_list_bench::run_key_type<std::string>(options);
+	skip_list_bench::run_key_type<user_class<int>>(options);
+	return 0;
+}
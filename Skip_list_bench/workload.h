@@ -0,0 +1,163 @@
+#pragma once
+#include <bit>
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "random_number.h"
+
+namespace skip_list_bench
+{
+	class latency_histogram final
+	{
+		static constexpr unsigned sub_bucket_bits = 5;
+		static constexpr uint64_t sub_bucket_count = uint64_t{ 1 } << sub_bucket_bits;
+		static constexpr size_t bucket_count = (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+		std::array<uint64_t, bucket_count> counts{};
+		uint64_t total = 0;
+		uint64_t sum = 0;
+		uint64_t maximum = 0;
+
+		[[nodiscard]] static size_t bucket_index(const uint64_t value) noexcept
+		{
+			if (value < sub_bucket_count)
+			{
+				return static_cast<size_t>(value);
+			}
+			const unsigned shift = static_cast<unsigned>(std::bit_width(value)) - sub_bucket_bits - 1;
+			return static_cast<size_t>((shift + 1) * sub_bucket_count + ((value >> shift) - sub_bucket_count));
+		}
+
+		[[nodiscard]] static uint64_t bucket_upper_bound(const size_t index) noexcept
+		{
+			if (index < sub_bucket_count)
+			{
+				return index;
+			}
+			const size_t shift = index / sub_bucket_count - 1;
+			const uint64_t mantissa = index % sub_bucket_count + sub_bucket_count;
+			return ((mantissa + 1) << shift) - 1;
+		}
+
+	public:
+		void record(const uint64_t value) noexcept
+		{
+			++counts[bucket_index(value)];
+			++total;
+			sum += value;
+			maximum = std::max(maximum, value);
+		}
+
+		void merge(const latency_histogram& other) noexcept
+		{
+			for (size_t index = 0; index < bucket_count; ++index)
+			{
+				counts[index] += other.counts[index];
+			}
+			total += other.total;
+			sum += other.sum;
+			maximum = std::max(maximum, other.maximum);
+		}
+
+		[[nodiscard]] uint64_t percentile(const double fraction) const noexcept
+		{
+			if (total == 0)
+			{
+				return 0;
+			}
+			const auto rank = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(total)));
+			uint64_t seen = 0;
+			for (size_t index = 0; index < bucket_count; ++index)
+			{
+				seen += counts[index];
+				if (seen >= std::max<uint64_t>(rank, 1))
+				{
+					return std::min(bucket_upper_bound(index), maximum);
+				}
+			}
+			return maximum;
+		}
+
+		[[nodiscard]] uint64_t count() const noexcept { return total; }
+		[[nodiscard]] uint64_t max() const noexcept { return maximum; }
+		[[nodiscard]] double mean() const noexcept { return total == 0 ? 0.0 : static_cast<double>(sum) / static_cast<double>(total); }
+	};
+
+	class zipfian_distribution final
+	{
+		uint64_t items;
+		double alpha;
+		double zeta_n;
+		double eta;
+		double half_pow_theta;
+
+		[[nodiscard]] static double zeta(const uint64_t count, const double theta_) noexcept
+		{
+			double sum = 0;
+			for (uint64_t index = 1; index <= count; ++index)
+			{
+				sum += 1.0 / std::pow(static_cast<double>(index), theta_);
+			}
+			return sum;
+		}
+
+	public:
+		explicit zipfian_distribution(const uint64_t items_, const double theta_ = 0.99)
+			: items(std::max<uint64_t>(items_, 1)), alpha(1.0 / (1.0 - theta_)), zeta_n(zeta(items, theta_)),
+			eta((1.0 - std::pow(2.0 / static_cast<double>(items), 1.0 - theta_)) / (1.0 - zeta(2, theta_) / zeta_n)),
+			half_pow_theta(1.0 + std::pow(0.5, theta_)) {}
+
+		template<typename Engine>
+		[[nodiscard]] uint64_t operator()(Engine& engine) const noexcept
+		{
+			const double uniform = static_cast<double>(engine() >> 11) * 0x1.0p-53;
+			const double scaled = uniform * zeta_n;
+			if (scaled < 1.0)
+			{
+				return 0;
+			}
+			if (scaled < half_pow_theta)
+			{
+				return 1;
+			}
+			return std::min(items - 1, static_cast<uint64_t>(static_cast<double>(items) * std::pow(eta * uniform - eta + 1.0, alpha)));
+		}
+	};
+
+	enum class key_distribution { uniform, zipfian, sequential, latest };
+
+	class key_chooser final
+	{
+		key_distribution distribution;
+		uint64_t items;
+		zipfian_distribution zipfian;
+		uint64_t next_sequential;
+
+	public:
+		key_chooser(const key_distribution distribution_, const uint64_t items_, const uint64_t first_sequential)
+			: distribution(distribution_), items(std::max<uint64_t>(items_, 1)),
+			zipfian(distribution_ == key_distribution::zipfian || distribution_ == key_distribution::latest ? items_ : 1),
+			next_sequential(first_sequential) {}
+
+		template<typename Engine>
+		[[nodiscard]] uint64_t operator()(Engine& engine, const uint64_t inserted) noexcept
+		{
+			switch (distribution)
+			{
+			case key_distribution::zipfian:
+				return random_tools::splitmix64(zipfian(engine))() % items;
+			case key_distribution::latest:
+				return std::max(inserted, items) - 1 - zipfian(engine);
+			case key_distribution::sequential:
+				return next_sequential++ % items;
+			default:
+				return engine() % items;
+			}
+		}
+	};
+
+	int run_workload(int argc, char** argv);
+}
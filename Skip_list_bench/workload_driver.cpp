@@ -0,0 +1,397 @@
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <string_view>
+#include <shared_mutex>
+#include "Skip_list.h"
+#include "workload.h"
+
+namespace skip_list_bench
+{
+	namespace
+	{
+		enum class operation : size_t { read, insert, update, scan, erase, read_modify_write };
+
+		constexpr size_t operation_count = 6;
+		constexpr std::array<const char*, operation_count> operation_names{ "read", "insert", "update", "scan", "erase", "rmw" };
+
+		struct workload_options
+		{
+			std::string target = "skip_list";
+			uint64_t records = 1000000;
+			uint64_t operations = 1000000;
+			size_t threads = 1;
+			size_t scan_length = 100;
+			key_distribution distribution = key_distribution::zipfian;
+			std::array<unsigned, operation_count> mix{ 50, 0, 50, 0, 0, 0 };
+		};
+
+		[[nodiscard]] bool parse_preset(const std::string_view name, workload_options& options)
+		{
+			options.distribution = key_distribution::zipfian;
+			if (name == "A" || name == "a")
+			{
+				options.mix = { 50, 0, 50, 0, 0, 0 };
+			}
+			else if (name == "B" || name == "b")
+			{
+				options.mix = { 95, 0, 5, 0, 0, 0 };
+			}
+			else if (name == "C" || name == "c")
+			{
+				options.mix = { 100, 0, 0, 0, 0, 0 };
+			}
+			else if (name == "D" || name == "d")
+			{
+				options.mix = { 95, 5, 0, 0, 0, 0 };
+				options.distribution = key_distribution::latest;
+			}
+			else if (name == "E" || name == "e")
+			{
+				options.mix = { 0, 5, 0, 95, 0, 0 };
+			}
+			else if (name == "F" || name == "f")
+			{
+				options.mix = { 50, 0, 0, 0, 0, 50 };
+			}
+			else
+			{
+				return false;
+			}
+			return true;
+		}
+
+		[[nodiscard]] bool parse_mix(std::string_view text, std::array<unsigned, operation_count>& mix)
+		{
+			mix.fill(0);
+			while (!text.empty())
+			{
+				const auto comma = text.find(',');
+				const auto item = text.substr(0, comma);
+				const auto colon = item.find(':');
+				if (colon == std::string_view::npos)
+				{
+					return false;
+				}
+				const auto name = item.substr(0, colon);
+				const auto found = std::find(operation_names.begin(), operation_names.end(), name);
+				if (found == operation_names.end())
+				{
+					return false;
+				}
+				mix[static_cast<size_t>(found - operation_names.begin())] = static_cast<unsigned>(std::strtoul(std::string(item.substr(colon + 1)).c_str(), nullptr, 10));
+				text = comma == std::string_view::npos ? std::string_view() : text.substr(comma + 1);
+			}
+			return std::any_of(mix.begin(), mix.end(), [](const unsigned weight) { return weight != 0; });
+		}
+
+		[[nodiscard]] bool parse_workload_options(const int argc, char** argv, workload_options& options)
+		{
+			for (int index = 1; index < argc; ++index)
+			{
+				const std::string_view argument(argv[index]);
+				const auto equals = argument.find('=');
+				if (!argument.starts_with("--") || equals == std::string_view::npos)
+				{
+					return false;
+				}
+				const auto name = argument.substr(2, equals - 2);
+				const auto value = argument.substr(equals + 1);
+				const auto number = std::strtoull(std::string(value).c_str(), nullptr, 10);
+				if (name == "target" && (value == "skip_list" || value == "sharded"))
+				{
+					options.target = std::string(value);
+				}
+				else if (name == "records")
+				{
+					options.records = std::max<uint64_t>(number, 1);
+				}
+				else if (name == "operations")
+				{
+					options.operations = number;
+				}
+				else if (name == "threads")
+				{
+					options.threads = std::max<size_t>(number, 1);
+				}
+				else if (name == "scan-length")
+				{
+					options.scan_length = std::max<size_t>(number, 1);
+				}
+				else if (name == "distribution" && value == "uniform")
+				{
+					options.distribution = key_distribution::uniform;
+				}
+				else if (name == "distribution" && value == "zipfian")
+				{
+					options.distribution = key_distribution::zipfian;
+				}
+				else if (name == "distribution" && value == "sequential")
+				{
+					options.distribution = key_distribution::sequential;
+				}
+				else if (name == "distribution" && value == "latest")
+				{
+					options.distribution = key_distribution::latest;
+				}
+				else if (!(name == "workload" && parse_preset(value, options)) && !(name == "mix" && parse_mix(value, options.mix)))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		class locked_skip_list final
+		{
+			mutable std::shared_mutex mutex;
+			skip_list_space::skip_list<uint64_t, uint64_t> list;
+
+		public:
+			explicit locked_skip_list(const workload_options& options)
+			{
+				std::vector<std::pair<uint64_t, uint64_t>> records;
+				records.reserve(options.records);
+				for (uint64_t key = 0; key < options.records; ++key)
+				{
+					records.emplace_back(key, key);
+				}
+				list.insert_sorted(records.begin(), records.end());
+			}
+
+			bool read(const uint64_t key) const
+			{
+				std::shared_lock lock(mutex);
+				const auto& view = list;
+				return view.find(key) != view.end();
+			}
+
+			bool insert(const uint64_t key, const uint64_t value)
+			{
+				std::unique_lock lock(mutex);
+				return list.insert(std::pair<uint64_t, uint64_t>(key, value)).second;
+			}
+
+			bool update(const uint64_t key, const uint64_t value)
+			{
+				std::unique_lock lock(mutex);
+				auto position = list.find(key);
+				if (position == list.end())
+				{
+					return false;
+				}
+				(*position).second = value;
+				return true;
+			}
+
+			bool read_modify_write(const uint64_t key)
+			{
+				std::unique_lock lock(mutex);
+				auto position = list.find(key);
+				if (position == list.end())
+				{
+					return false;
+				}
+				++(*position).second;
+				return true;
+			}
+
+			size_t scan(const uint64_t key, const size_t length) const
+			{
+				std::shared_lock lock(mutex);
+				const auto& view = list;
+				size_t visited = 0;
+				for (auto position = view.lower_bound(key); position != view.end() && (*position).first < key + length; ++position)
+				{
+					++visited;
+				}
+				return visited;
+			}
+
+			bool erase(const uint64_t key)
+			{
+				std::unique_lock lock(mutex);
+				const size_t old_size = list.size();
+				return list.erase(key) != old_size;
+			}
+		};
+
+		class sharded_target final
+		{
+			skip_list_space::sharded_skip_list<uint64_t, uint64_t> list;
+
+			[[nodiscard]] static std::vector<uint64_t> initial_split_keys(const workload_options& options)
+			{
+				const uint64_t shard_count = options.threads * 4;
+				std::vector<uint64_t> split_keys;
+				for (uint64_t shard = 1; shard < shard_count; ++shard)
+				{
+					split_keys.push_back(options.records * shard / shard_count);
+				}
+				return split_keys;
+			}
+
+		public:
+			explicit sharded_target(const workload_options& options) : list(initial_split_keys(options))
+			{
+				for (uint64_t key = 0; key < options.records; ++key)
+				{
+					list.insert(std::pair<uint64_t, uint64_t>(key, key));
+				}
+			}
+
+			bool read(const uint64_t key) const { return list.contains(key); }
+			bool insert(const uint64_t key, const uint64_t value) { return list.insert(std::pair<uint64_t, uint64_t>(key, value)); }
+			bool update(const uint64_t key, const uint64_t value) { return !list.insert_or_assign(key, value); }
+			bool erase(const uint64_t key) { return list.erase(key); }
+
+			bool read_modify_write(const uint64_t key)
+			{
+				const auto value = list.find(key);
+				return value.has_value() && !list.insert_or_assign(key, *value + 1);
+			}
+
+			size_t scan(const uint64_t key, const size_t length) const
+			{
+				size_t visited = 0;
+				list.for_each_in_range(key, key + length, [&visited](const uint64_t&, const uint64_t&) { ++visited; });
+				return visited;
+			}
+		};
+
+		using operation_histograms = std::array<latency_histogram, operation_count>;
+
+		template<typename Target>
+		uint64_t run_operations(Target& target, const workload_options& options, key_chooser chooser, const uint64_t seed,
+			const uint64_t operations, std::atomic<uint64_t>& next_insert_key, operation_histograms& histograms)
+		{
+			random_tools::splitmix64 engine(seed);
+			std::array<unsigned, operation_count> thresholds{};
+			unsigned total_weight = 0;
+			for (size_t index = 0; index < operation_count; ++index)
+			{
+				total_weight += options.mix[index];
+				thresholds[index] = total_weight;
+			}
+			uint64_t hits = 0;
+			for (uint64_t count = 0; count < operations; ++count)
+			{
+				const auto roll = static_cast<unsigned>(engine() % total_weight);
+				const auto chosen = static_cast<size_t>(std::upper_bound(thresholds.begin(), thresholds.end(), roll) - thresholds.begin());
+				const uint64_t key = chooser(engine, next_insert_key.load(std::memory_order_relaxed));
+				const auto start = std::chrono::steady_clock::now();
+				switch (static_cast<operation>(chosen))
+				{
+				case operation::read:
+					hits += target.read(key) ? 1 : 0;
+					break;
+				case operation::insert:
+					hits += target.insert(next_insert_key.fetch_add(1, std::memory_order_relaxed), key) ? 1 : 0;
+					break;
+				case operation::update:
+					hits += target.update(key, count) ? 1 : 0;
+					break;
+				case operation::scan:
+					hits += target.scan(key, options.scan_length);
+					break;
+				case operation::erase:
+					hits += target.erase(key) ? 1 : 0;
+					break;
+				case operation::read_modify_write:
+					hits += target.read_modify_write(key) ? 1 : 0;
+					break;
+				}
+				const auto stop = std::chrono::steady_clock::now();
+				histograms[chosen].record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count()));
+			}
+			return hits;
+		}
+
+		template<typename Target>
+		void run_target(const workload_options& options)
+		{
+			const auto load_start = std::chrono::steady_clock::now();
+			Target target(options);
+			const double load_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - load_start).count();
+			const key_chooser chooser(options.distribution, options.records, 0);
+			std::atomic<uint64_t> next_insert_key{ options.records };
+			std::atomic<uint64_t> hits{ 0 };
+			std::atomic<bool> started{ false };
+			std::vector<operation_histograms> histograms(options.threads);
+			std::vector<std::thread> threads;
+			for (size_t thread = 0; thread < options.threads; ++thread)
+			{
+				const uint64_t operations = options.operations / options.threads + (thread < options.operations % options.threads ? 1 : 0);
+				threads.emplace_back([&, thread, operations]
+					{
+						key_chooser local_chooser = chooser;
+						if (options.distribution == key_distribution::sequential)
+						{
+							local_chooser = key_chooser(options.distribution, options.records, options.records / options.threads * thread);
+						}
+						while (!started.load(std::memory_order_acquire))
+						{
+							std::this_thread::yield();
+						}
+						hits.fetch_add(run_operations(target, options, local_chooser, thread + 1, operations, next_insert_key, histograms[thread]),
+							std::memory_order_relaxed);
+					});
+			}
+			const auto start = std::chrono::steady_clock::now();
+			started.store(true, std::memory_order_release);
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+			const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			operation_histograms merged;
+			for (const auto& thread_histograms : histograms)
+			{
+				for (size_t index = 0; index < operation_count; ++index)
+				{
+					merged[index].merge(thread_histograms[index]);
+				}
+			}
+			std::printf("target %s, threads %zu, records %llu, operations %llu, load %.2f s, hits %llu\n", options.target.c_str(), options.threads,
+				static_cast<unsigned long long>(options.records), static_cast<unsigned long long>(options.operations), load_seconds,
+				static_cast<unsigned long long>(hits.load()));
+			std::printf("throughput %.0f ops/s\n", static_cast<double>(options.operations) / seconds);
+			std::printf("%-10s %12s %12s %10s %10s %10s %12s\n", "operation", "count", "mean ns", "p50", "p99", "p999", "max");
+			for (size_t index = 0; index < operation_count; ++index)
+			{
+				const auto& histogram = merged[index];
+				if (histogram.count() == 0)
+				{
+					continue;
+				}
+				std::printf("%-10s %12llu %12.1f %10llu %10llu %10llu %12llu\n", operation_names[index],
+					static_cast<unsigned long long>(histogram.count()), histogram.mean(),
+					static_cast<unsigned long long>(histogram.percentile(0.50)), static_cast<unsigned long long>(histogram.percentile(0.99)),
+					static_cast<unsigned long long>(histogram.percentile(0.999)), static_cast<unsigned long long>(histogram.max()));
+			}
+		}
+	}
+
+	int run_workload(const int argc, char** argv)
+	{
+		workload_options options;
+		if (!parse_workload_options(argc, argv, options))
+		{
+			std::fprintf(stderr, "usage: workload [--target=skip_list|sharded] [--workload=A..F | --mix=read:50,insert:0,update:50,scan:0,erase:0,rmw:0]\n"
+				"                [--records=N] [--operations=N] [--threads=N] [--distribution=uniform|zipfian|sequential|latest] [--scan-length=N]\n");
+			return 2;
+		}
+		if (options.target == "sharded")
+		{
+			run_target<sharded_target>(options);
+		}
+		else
+		{
+			run_target<locked_skip_list>(options);
+		}
+		return 0;
+	}
+}
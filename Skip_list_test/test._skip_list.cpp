@@ -1,5 +1,6 @@
-#include "pch.h"
+﻿#include "pch.h"
 #include <crtdbg.h> 
+#include <sstream>
 #include "Skip_list.h"
 #include "user_class.h"
 
@@ -471,12 +472,27 @@ TEST_F(SkipListTest, ComparisonListsAnyMaxLevel) {
 	EXPECT_TRUE(list1 == list2);
 }
 
+TEST_F(SkipListTest, ComparisonListsAnyParameters) {
+	using generator = random_tools::level_generator<random_tools::xorshift64, random_tools::promotion_quarter>;
+	skip_list_space::indexable_skip_list<int, int> indexable{ { 1, 10 }, { 2, 20 } };
+	skip_list_space::indexable_skip_list<int, int> other_indexable{ { 1, 10 }, { 2, 20 } };
+	skip_list_space::skip_list<int, int, std::less<int>, 16, std::allocator<std::pair<const int, int>>, generator> custom{ { 1, 10 }, { 2, 20 } };
+	skip_list_space::single_writer_skip_list<int, int> shared;
+	shared.insert(std::pair<int, int>(1, 10));
+	shared.insert(std::pair<int, int>(2, 20));
+	EXPECT_TRUE(indexable == other_indexable);
+	EXPECT_TRUE(indexable == custom && custom == shared && shared == indexable);
+	custom[2] = 21;
+	EXPECT_TRUE(custom != indexable && shared != custom);
+}
+
 TEST_F(SkipListTest, ListSeed) {
 	constexpr unsigned int new_seed = 9438U;
+	using generator = random_tools::level_generator<std::mt19937, random_tools::promotion_half, new_seed>;
 	skip_list_space::skip_list<user_class<size_t>, size_t, std::less<>,
-		20, std::allocator<std::pair<const user_class<size_t>, size_t>>, new_seed> list1;
+		20, std::allocator<std::pair<const user_class<size_t>, size_t>>, generator> list1;
 	skip_list_space::skip_list<size_t, size_t, std::less<>, 20,
-		std::allocator<std::pair<const size_t, size_t>>, new_seed> list2;
+		std::allocator<std::pair<const size_t, size_t>>, generator> list2;
 	const size_t size = 200;
 	for (size_t i = 0; i < size; ++i)
 	{
@@ -490,4 +506,572 @@ TEST_F(SkipListTest, ListSeed) {
 	{
 		EXPECT_TRUE((++iter_list1).get_node_value()->get_level() == (++iter_list2).get_node_value()->get_level());
 	}
-}
\ No newline at end of file
+}
+
+TEST_F(SkipListTest, EraseShuffledKeys) {
+	auto list = skip_list_space::skip_list<size_t, size_t, std::less<>, 16>();
+	constexpr size_t size = 1000;
+	std::vector<size_t> keys;
+	for (size_t index = 0; index < size; ++index)
+	{
+		list.insert(std::pair(index, index));
+		keys.push_back(index);
+	}
+	std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+	for (size_t index = 0; index < size; ++index)
+	{
+		list.erase(keys[index]);
+		EXPECT_TRUE(list.size() == size - index - 1);
+		EXPECT_TRUE(list.find(keys[index]) == list.end());
+		if (index + 1 < size)
+		{
+			EXPECT_TRUE((*list.find(keys[index + 1])).second == keys[index + 1]);
+		}
+	}
+	EXPECT_TRUE(list.empty());
+	list.insert(std::pair(size, size));
+	EXPECT_TRUE((*list.begin()).first == size);
+}
+
+
+TEST_F(SkipListTest, EraseMiddleRange) {
+	auto list = skip_list_space::skip_list<size_t, size_t, std::less<>, 16>();
+	constexpr size_t size = 1000;
+	for (size_t index = 0; index < size; ++index)
+	{
+		list.insert(std::pair(index, index));
+	}
+	list.erase(list.find(100), list.find(900));
+	EXPECT_TRUE(list.size() == 200);
+	for (size_t index = 0; index < size; ++index)
+	{
+		EXPECT_TRUE((list.find(index) == list.end()) == (index >= 100 && index < 900));
+	}
+	auto list_iterator = list.find(900);
+	EXPECT_TRUE((*--list_iterator).first == 99);
+	list.erase(list.find(50), list.end());
+	EXPECT_TRUE(list.size() == 50);
+	EXPECT_TRUE((*--list.end()).first == 49);
+	list.insert(std::pair(size, size));
+	EXPECT_TRUE((*--list.end()).first == size);
+	list.clear();
+	EXPECT_TRUE(list.empty());
+	EXPECT_TRUE(list.begin() == list.end());
+	list.insert(std::pair(size, size));
+	EXPECT_TRUE(list.size() == 1);
+}
+
+
+TEST_F(SkipListTest, GrowingMaxLevel) {
+	auto list = skip_list_space::skip_list<size_t, size_t, std::less<>, 64>();
+	constexpr size_t size = 1 << 16;
+	list.insert(std::pair(size, size));
+	auto last_iterator = list.begin();
+	size_t max_level = 0;
+	for (size_t index = 0; index < size; ++index)
+	{
+		auto inserted = list.insert(std::pair(index, index)).first;
+		max_level = std::max<size_t>(max_level, inserted.get_node_value()->get_level());
+	}
+	EXPECT_TRUE(max_level > 10);
+	EXPECT_TRUE(max_level <= 17);
+	EXPECT_TRUE((*--last_iterator).first == size - 1);
+	for (size_t index = 0; index < size; index += 97)
+	{
+		EXPECT_TRUE((*list.find(index)).second == index);
+	}
+	const auto copy_list = list;
+	EXPECT_TRUE(copy_list == list);
+	auto first_iterator = list.begin();
+	EXPECT_THROW(--(--first_iterator), std::out_of_range);
+}
+
+
+TEST_F(SkipListTest, MoveAssignTallIntoShort) {
+	auto tall = skip_list_space::skip_list<size_t, size_t>();
+	constexpr size_t size = 100000;
+	for (size_t index = 0; index < size; ++index)
+	{
+		tall.insert(std::pair(index, index));
+	}
+	auto short_list = skip_list_space::skip_list<size_t, size_t>{ { size, size } };
+	short_list = std::move(tall);
+	EXPECT_TRUE(short_list.size() == size);
+	for (size_t index = 0; index < size; index += 7)
+	{
+		short_list.erase(index);
+	}
+	EXPECT_TRUE((*short_list.find(size - 1)).second == size - 1);
+	tall.erase(size);
+	EXPECT_TRUE(tall.empty() && tall.begin() == tall.end());
+	for (size_t index = 0; index < 1000; ++index)
+	{
+		tall.insert(std::pair(index, index));
+	}
+	tall.erase(tall.find(10), tall.find(900));
+	EXPECT_TRUE(tall.size() == 110 && tall.find(999) != tall.end() && tall.find(10) == tall.end());
+}
+
+
+TEST_F(SkipListTest, NodeAllocatorRebind) {
+	using allocator = counting_allocator<std::pair<const size_t, size_t>>;
+	const size_t start_allocated = allocator::allocated;
+	const size_t start_deallocated = allocator::deallocated;
+	{
+		skip_list_space::skip_list<size_t, size_t, std::less<>, 16, allocator> list;
+		constexpr size_t size = 1000;
+		for (size_t index = 0; index < size; ++index)
+		{
+			list.insert(std::pair(index, index));
+		}
+		EXPECT_TRUE(allocator::allocated > start_allocated);
+		const size_t filled_allocated = allocator::allocated;
+		list.clear();
+		for (size_t index = 0; index < size; ++index)
+		{
+			list.insert(std::pair(size - index, index));
+		}
+		EXPECT_TRUE(allocator::deallocated == start_deallocated);
+		EXPECT_TRUE(list.size() == size);
+		list.erase(list.begin(), list.end());
+		list.shrink_to_fit();
+		EXPECT_TRUE(allocator::deallocated > start_deallocated);
+		EXPECT_TRUE(allocator::allocated >= filled_allocated);
+	}
+	EXPECT_TRUE(allocator::allocated - start_allocated == allocator::deallocated - start_deallocated);
+}
+
+
+TEST_F(SkipListTest, MonotonicArena) {
+	std::vector<std::byte> buffer(1 << 20);
+	std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+	{
+		skip_list_space::pmr::skip_list<size_t, std::pmr::string> list(&arena);
+		constexpr size_t size = 100;
+		for (size_t index = 0; index < size; ++index)
+		{
+			list.insert(std::pair(index, std::pmr::string("string number: " + std::to_string(index))));
+		}
+		EXPECT_TRUE((*list.find(10)).second.get_allocator().resource() == &arena);
+		EXPECT_TRUE((*list.find(10)).second == "string number: 10");
+	}
+	size_t remaining = 0;
+	{
+		skip_list_space::pmr::skip_list<size_t, size_t> list(&arena);
+		constexpr size_t size = 1000;
+		for (size_t index = 0; index < size; ++index)
+		{
+			list.insert(std::pair(index, index));
+		}
+		list.erase(list.find(10), list.find(20));
+		EXPECT_TRUE(list.size() == size - 10);
+		EXPECT_TRUE((*list.find(500)).second == 500);
+		const auto next_free = static_cast<std::byte*>(arena.allocate(1, 1));
+		remaining = static_cast<size_t>(buffer.data() + buffer.size() - next_free) - 1;
+	}
+	EXPECT_NO_THROW(static_cast<void>(arena.allocate(remaining, 1)));
+	EXPECT_THROW(static_cast<void>(arena.allocate(1, 1)), std::bad_alloc);
+}
+
+TEST_F(SkipListTest, PolymorphicAllocatorAssignment) {
+	using list_type = skip_list_space::pmr::skip_list<size_t, std::pmr::string>;
+	static_assert(std::is_nothrow_move_assignable_v<skip_list_space::skip_list<size_t, std::string>> && !std::is_nothrow_move_assignable_v<list_type>);
+	std::pmr::monotonic_buffer_resource first_arena;
+	std::pmr::monotonic_buffer_resource second_arena;
+	const auto fill = [](list_type& list, const size_t first, const size_t count)
+	{
+		for (size_t index = first; index < first + count; ++index)
+		{
+			list.insert(std::pair(index, std::pmr::string("long enough to leave the small buffer: " + std::to_string(index))));
+		}
+	};
+	const auto uses_arena = [](const list_type& list, std::pmr::memory_resource* arena)
+	{
+		return list.get_allocator().resource() == arena && std::all_of(list.begin(), list.end(),
+			[arena](const auto& entry) { return entry.second.get_allocator().resource() == arena; });
+	};
+	list_type first(&first_arena);
+	list_type second(&second_arena);
+	fill(first, 0, 300);
+	fill(second, 1000, 50);
+	first.swap(second);
+	EXPECT_TRUE(first.size() == 50 && second.size() == 300);
+	EXPECT_TRUE((*first.begin()).first == 1000 && (*second.begin()).first == 0);
+	EXPECT_TRUE(uses_arena(first, &first_arena) && uses_arena(second, &second_arena));
+	first = second;
+	EXPECT_TRUE(first == second && uses_arena(first, &first_arena));
+	fill(second, 5000, 10);
+	first = std::move(second);
+	EXPECT_TRUE(first.size() == 310 && (*first.find(5009)).second.ends_with("5009"));
+	EXPECT_TRUE(uses_arena(first, &first_arena));
+	first.erase(first.find(100), first.find(5005));
+	second = std::move(first);
+	EXPECT_TRUE(second.size() == 105 && uses_arena(second, &second_arena));
+	list_type same_arena(&second_arena);
+	fill(same_arena, 0, 20);
+	same_arena.swap(second);
+	EXPECT_TRUE(same_arena.size() == 105 && second.size() == 20 && uses_arena(same_arena, &second_arena));
+}
+
+
+TEST_F(SkipListTest, BulkConstruction) {
+	using list_type = skip_list_space::skip_list<size_t, size_t, std::less<>, 20>;
+	constexpr size_t size = 1000;
+	std::vector<std::pair<size_t, size_t>> sorted_values;
+	for (size_t index = 0; index < size; ++index)
+	{
+		sorted_values.emplace_back(index, index);
+	}
+	list_type sorted_list(skip_list_space::sorted_unique, sorted_values.begin(), sorted_values.end());
+	list_type detected_list(sorted_values.begin(), sorted_values.end());
+	auto shuffled_values = sorted_values;
+	shuffled_values.emplace_back(5, 100);
+	std::shuffle(shuffled_values.begin(), shuffled_values.end(), std::mt19937(42));
+	list_type unsorted_list(shuffled_values.begin(), shuffled_values.end());
+	EXPECT_TRUE(sorted_list.size() == size);
+	EXPECT_TRUE(sorted_list == detected_list);
+	EXPECT_TRUE(unsorted_list.size() == size);
+	auto list_iterator = unsorted_list.begin();
+	for (size_t index = 0; index < size; ++index, ++list_iterator)
+	{
+		EXPECT_TRUE((*list_iterator).first == index);
+		EXPECT_TRUE((*sorted_list.find(index)).second == index);
+	}
+	EXPECT_TRUE((*--sorted_list.end()).first == size - 1);
+	sorted_list.insert(std::pair(size, size));
+	EXPECT_TRUE(sorted_list.size() == size + 1);
+
+	std::vector<std::pair<size_t, size_t>> reversed(sorted_values.rbegin(), sorted_values.rend());
+	detected_list.assign(reversed.begin(), reversed.end());
+	EXPECT_TRUE(detected_list.size() == size);
+	EXPECT_TRUE((*detected_list.begin()).first == 0);
+	detected_list.assign({ std::pair<const size_t, size_t>(3, 3), std::pair<const size_t, size_t>(1, 1) });
+	EXPECT_TRUE(detected_list.size() == 2);
+	EXPECT_TRUE((*detected_list.begin()).first == 1);
+	detected_list.assign({ std::pair<const size_t, size_t>(1, 1), std::pair<const size_t, size_t>(2, 2), std::pair<const size_t, size_t>(2, 20) });
+	EXPECT_TRUE(detected_list.size() == 2);
+	EXPECT_TRUE((*detected_list.find(2)).second == 2);
+	detected_list.assign(skip_list_space::sorted_unique, sorted_values.begin(), sorted_values.begin() + 10);
+	EXPECT_TRUE(detected_list.size() == 10);
+	EXPECT_TRUE((*--detected_list.end()).first == 9);
+}
+
+
+template<typename List>
+void check_indexes(List& list, const std::vector<size_t>& keys)
+{
+	ASSERT_TRUE(list.size() == keys.size());
+	for (size_t index = 0; index < keys.size(); ++index)
+	{
+		EXPECT_TRUE((*list.nth(index)).first == keys[index]);
+		EXPECT_TRUE(list.rank(keys[index]) == index);
+		EXPECT_TRUE(list.nth(index) - list.begin() == static_cast<std::ptrdiff_t>(index));
+		EXPECT_TRUE(list.end() - list.nth(index) == static_cast<std::ptrdiff_t>(keys.size() - index));
+	}
+	EXPECT_TRUE(list.nth(keys.size()) == list.end());
+}
+
+TEST_F(SkipListTest, IndexableList) {
+	using list_type = skip_list_space::indexable_skip_list<size_t, size_t, std::less<>, 20>;
+	list_type list;
+	EXPECT_TRUE(list.rank(0) == 0);
+	EXPECT_TRUE(list.nth(0) == list.end());
+	std::vector<size_t> keys;
+	std::mt19937 generator(7);
+	for (size_t index = 0; index < 500; ++index)
+	{
+		const size_t key = generator() % 2000;
+		if (list.insert(std::pair(key, key)).second)
+		{
+			keys.insert(std::lower_bound(keys.begin(), keys.end(), key), key);
+		}
+	}
+	check_indexes(list, keys);
+	EXPECT_TRUE(list.rank(keys[10] + 1) == 11);
+	for (size_t index = 0; index < 100; ++index)
+	{
+		const size_t key = keys[generator() % keys.size()];
+		list.erase(key);
+		keys.erase(std::lower_bound(keys.begin(), keys.end(), key));
+	}
+	check_indexes(list, keys);
+	list.erase(list.nth(50), list.nth(150));
+	keys.erase(keys.begin() + 50, keys.begin() + 150);
+	check_indexes(list, keys);
+	list.erase(list.nth(keys.size() - 20), list.end());
+	keys.erase(keys.end() - 20, keys.end());
+	check_indexes(list, keys);
+	const auto copy_list = list;
+	EXPECT_TRUE((*copy_list.nth(42)).first == keys[42]);
+	EXPECT_TRUE(copy_list.rank(keys[42]) == 42);
+
+	std::vector<std::pair<size_t, size_t>> values;
+	keys.clear();
+	for (size_t index = 0; index < 1000; ++index)
+	{
+		values.emplace_back(index * 2, index);
+		keys.push_back(index * 2);
+	}
+	list.assign(values.begin(), values.end());
+	check_indexes(list, keys);
+	list.clear();
+	keys.clear();
+	check_indexes(list, keys);
+	list.insert(std::pair(1, 1));
+	keys.push_back(1);
+	check_indexes(list, keys);
+}
+
+
+TEST_F(SkipListTest, OrderedSearch) {
+	auto list = skip_list_space::skip_list<size_t, size_t>();
+	EXPECT_TRUE(list.lower_bound(0) == list.end());
+	EXPECT_TRUE(list.range(0, 10).empty());
+	constexpr size_t size = 200;
+	for (size_t index = 0; index < size; ++index)
+	{
+		list.insert(std::pair(index * 2, index));
+	}
+	EXPECT_TRUE((*list.lower_bound(10)).first == 10);
+	EXPECT_TRUE((*list.lower_bound(11)).first == 12);
+	EXPECT_TRUE((*list.upper_bound(10)).first == 12);
+	EXPECT_TRUE(list.lower_bound(size * 2) == list.end());
+	EXPECT_TRUE(list.upper_bound(size * 2 - 2) == list.end());
+	auto [lower, upper] = list.equal_range(20);
+	EXPECT_TRUE((*lower).first == 20);
+	EXPECT_TRUE((*upper).first == 22);
+	auto [missing_lower, missing_upper] = list.equal_range(21);
+	EXPECT_TRUE(missing_lower == missing_upper);
+
+	size_t expected_key = 100;
+	for (auto& [key, value] : list.range(99, 151))
+	{
+		EXPECT_TRUE(key == expected_key);
+		value = 0;
+		expected_key += 2;
+	}
+	EXPECT_TRUE(expected_key == 152);
+	const auto& const_list = list;
+	size_t count = 0;
+	for (const auto& [key, value] : const_list.range(100, 152))
+	{
+		EXPECT_TRUE(value == 0);
+		++count;
+	}
+	EXPECT_TRUE(count == 26);
+	EXPECT_TRUE(const_list.range(151, 152).empty());
+	count = 0;
+	for ([[maybe_unused]] const auto& value : const_list.range(390, size * 4))
+	{
+		++count;
+	}
+	EXPECT_TRUE(count == 5);
+	auto reversed = skip_list_space::skip_list<size_t, size_t, std::greater<>>(std::greater<>());
+	for (size_t index = 0; index < size; ++index)
+	{
+		reversed.insert(std::pair(index, index));
+	}
+	EXPECT_TRUE((*reversed.lower_bound(50)).first == 50);
+	EXPECT_TRUE((*reversed.upper_bound(50)).first == 49);
+}
+
+
+TEST_F(SkipListTest, FingerLocalAccess) {
+	auto list = skip_list_space::indexable_skip_list<int, int>();
+	std::vector<int> keys;
+	std::mt19937 generator(11);
+	int cursor = 0;
+	for (size_t step = 0; step < 20000; ++step)
+	{
+		cursor += static_cast<int>(generator() % 7) - 2;
+		const auto key_position = std::lower_bound(keys.begin(), keys.end(), cursor);
+		const bool present = key_position != keys.end() && *key_position == cursor;
+		switch (generator() % 3)
+		{
+		case 0:
+			EXPECT_TRUE(list.insert(std::pair(cursor, cursor)).second == !present);
+			if (!present)
+			{
+				keys.insert(key_position, cursor);
+			}
+			break;
+		case 1:
+			list.erase(cursor);
+			if (present)
+			{
+				keys.erase(key_position);
+			}
+			break;
+		default:
+			EXPECT_TRUE((list.find(cursor) != list.end()) == present);
+			break;
+		}
+		if (step % 500 == 0)
+		{
+			list.erase(list.lower_bound(cursor - 3), list.lower_bound(cursor));
+			keys.erase(std::lower_bound(keys.begin(), keys.end(), cursor - 3), std::lower_bound(keys.begin(), keys.end(), cursor));
+		}
+	}
+	ASSERT_TRUE(list.size() == keys.size());
+	for (size_t index = 0; index < keys.size(); ++index)
+	{
+		EXPECT_TRUE((*list.nth(index)).first == keys[index]);
+		EXPECT_TRUE(list.rank(keys[index]) == index);
+	}
+}
+
+
+TEST_F(SkipListTest, InsertSortedBatch) {
+	auto list = skip_list_space::indexable_skip_list<size_t, size_t>();
+	std::vector<std::pair<size_t, size_t>> batch;
+	for (size_t index = 0; index < 500; ++index)
+	{
+		batch.emplace_back(index * 4, index);
+	}
+	EXPECT_TRUE(list.insert_sorted(batch.begin(), batch.end()) == 500);
+	std::vector<size_t> keys;
+	for (const auto& [key, value] : batch)
+	{
+		keys.push_back(key);
+	}
+	for (size_t round = 1; round < 4; ++round)
+	{
+		batch.clear();
+		for (size_t index = 0; index < 600; ++index)
+		{
+			batch.emplace_back(index * 4 + round, index);
+		}
+		batch.emplace_back(0, 99);
+		std::sort(batch.begin(), batch.end());
+		EXPECT_TRUE(list.insert_sorted(batch.begin(), batch.end()) == 600);
+		for (size_t index = 0; index < 600; ++index)
+		{
+			keys.push_back(index * 4 + round);
+		}
+	}
+	std::sort(keys.begin(), keys.end());
+	ASSERT_TRUE(list.size() == keys.size());
+	size_t index = 0;
+	for (const auto& [key, value] : list)
+	{
+		EXPECT_TRUE(key == keys[index]);
+		EXPECT_TRUE(list.rank(key) == index);
+		++index;
+	}
+	EXPECT_TRUE((*list.find(0)).second == 0);
+	EXPECT_TRUE((*list.find(10)).second == 2);
+	EXPECT_TRUE((*--list.end()).first == keys.back());
+}
+
+
+TEST_F(SkipListTest, FindManyInterleaved) {
+	auto list = skip_list_space::skip_list<size_t, size_t>();
+	for (size_t index = 0; index < 3000; ++index)
+	{
+		list.insert(std::pair<size_t, size_t>(index * 2, index));
+	}
+	std::vector<size_t> keys;
+	for (size_t index = 0; index < 1000; ++index)
+	{
+		keys.push_back((index * 7919) % 6500);
+	}
+	std::vector<skip_list_space::skip_list<size_t, size_t>::iterator> found;
+	list.find_many(keys.begin(), keys.end(), std::back_inserter(found));
+	ASSERT_TRUE(found.size() == keys.size());
+	for (size_t index = 0; index < keys.size(); ++index)
+	{
+		EXPECT_TRUE(found[index] == list.find(keys[index]));
+	}
+	const auto& const_list = list;
+	std::vector<skip_list_space::skip_list<size_t, size_t>::const_iterator> const_found;
+	const_list.find_many(keys.begin(), keys.begin() + 5, std::back_inserter(const_found));
+	EXPECT_TRUE(const_found[4] == const_list.find(keys[4]));
+	auto empty_list = skip_list_space::skip_list<size_t, size_t>();
+	found.clear();
+	empty_list.find_many(keys.begin(), keys.begin() + 3, std::back_inserter(found));
+	EXPECT_TRUE(found.size() == 3 && found[0] == empty_list.end());
+}
+
+TEST_F(SkipListTest, SaveAndLoad) {
+	auto list = skip_list_space::indexable_skip_list<int, std::string>();
+	for (int index = 0; index < 2000; ++index)
+	{
+		list.insert(std::pair<int, std::string>(index * 3 - 100, std::to_string(index)));
+	}
+	std::stringstream stream;
+	list.save(stream);
+	auto loaded = skip_list_space::indexable_skip_list<int, std::string>{ { 5, "stale" } };
+	loaded.load(stream);
+	EXPECT_TRUE(std::equal(loaded.begin(), loaded.end(), list.begin(), list.end()));
+	EXPECT_TRUE(loaded.rank(500) == list.rank(500));
+	EXPECT_TRUE(loaded.at(-100) == "0");
+	loaded.insert(std::pair<int, std::string>(-1000, "first"));
+	EXPECT_TRUE((*loaded.begin()).second == "first");
+	std::vector<std::byte> buffer;
+	list.save(buffer);
+	auto from_buffer = skip_list_space::skip_list<int, std::string>();
+	EXPECT_TRUE(from_buffer.load(buffer) == buffer.size());
+	EXPECT_TRUE(from_buffer.size() == list.size());
+	EXPECT_TRUE(from_buffer.at(5897) == "1999");
+	std::vector<std::byte> saved_again;
+	from_buffer.save(saved_again);
+	EXPECT_TRUE(saved_again == buffer);
+	auto empty_list = skip_list_space::skip_list<int, std::string>();
+	std::vector<std::byte> empty_buffer;
+	empty_list.save(empty_buffer);
+	EXPECT_TRUE(from_buffer.load(empty_buffer) == empty_buffer.size());
+	EXPECT_TRUE(from_buffer.empty());
+	buffer.resize(buffer.size() / 2);
+	EXPECT_THROW(from_buffer.load(buffer), std::runtime_error);
+	EXPECT_TRUE(from_buffer.empty());
+	from_buffer.insert(std::pair<int, std::string>(1, "stale"));
+	buffer[0] = std::byte{ 0 };
+	EXPECT_THROW(from_buffer.load(buffer), std::runtime_error);
+	EXPECT_TRUE(from_buffer.empty());
+	std::vector<std::byte> hostile;
+	auto single = skip_list_space::skip_list<int, std::string>{ { 1, "one" } };
+	single.save(hostile);
+	const uint64_t huge_length = uint64_t{ 1 } << 60;
+	std::memcpy(hostile.data() + 2 * sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint8_t) + sizeof(int), &huge_length, sizeof(huge_length));
+	EXPECT_THROW(from_buffer.load(hostile), std::runtime_error);
+	std::stringstream hostile_stream(std::string(reinterpret_cast<const char*>(hostile.data()), hostile.size()));
+	EXPECT_THROW(from_buffer.load(hostile_stream), std::runtime_error);
+	EXPECT_TRUE(from_buffer.empty());
+}
+
+TEST_F(SkipListTest, Statistics) {
+	auto list = skip_list_space::instrumented_skip_list<size_t, size_t>();
+	static_assert(sizeof(skip_list_space::skip_list<size_t, size_t>) < sizeof(list));
+	for (size_t index = 0; index < 1000; ++index)
+	{
+		list.insert(std::pair<size_t, size_t>(index * 7 % 1000, index));
+	}
+	list.reset_statistics();
+	const auto& const_list = list;
+	for (size_t index = 0; index < 100; ++index)
+	{
+		EXPECT_TRUE(const_list.find(index * 10) != const_list.end());
+	}
+	list.erase(5);
+	list.erase(list.find(6), list.find(16));
+	const auto statistics = list.statistics();
+	EXPECT_TRUE(statistics.inserts == 0);
+	EXPECT_TRUE(statistics.finds == 102);
+	EXPECT_TRUE(statistics.erases == 11);
+	EXPECT_TRUE(statistics.searches >= 100);
+	EXPECT_TRUE(statistics.comparisons >= statistics.nodes_visited && statistics.nodes_visited > 0);
+	EXPECT_TRUE(statistics.comparisons_per_search() < 100);
+	EXPECT_TRUE(statistics.list_level > 0 && statistics.list_level <= statistics.head_level);
+	size_t live_nodes = 0;
+	for (size_t lvl = 0; lvl < statistics.level_histogram.size(); ++lvl)
+	{
+		live_nodes += statistics.level_histogram[lvl];
+		EXPECT_TRUE(lvl < statistics.list_level || statistics.level_histogram[lvl] == 0);
+	}
+	EXPECT_TRUE(live_nodes == list.size());
+	EXPECT_TRUE(statistics.level_histogram[0] > statistics.level_histogram[1]);
+	EXPECT_TRUE(statistics.bytes_allocated >= list.size() * sizeof(std::pair<size_t, size_t>));
+	list.clear();
+	EXPECT_TRUE(list.statistics().level_histogram[0] == 0);
+	EXPECT_TRUE(list.statistics().bytes_allocated >= statistics.bytes_allocated);
+}
@@ -0,0 +1,588 @@
+#include "pch.h"
+#include <crtdbg.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <optional>
+#include <string>
+#include "Skip_list.h"
+
+class ConcurrentSkipListTest : public ::testing::Test {
+protected:
+	virtual void SetUp(void) {
+		_CrtMemCheckpoint(&startup);
+	}
+	virtual void TearDown(void) {
+		_CrtMemState teardown, diff;
+		_CrtMemCheckpoint(&teardown);
+		ASSERT_EQ(0, _CrtMemDifference(&diff, &startup, &teardown)) << "Memory leaks detected";
+	}
+	_CrtMemState startup;
+};
+
+static constexpr size_t thread_count = 4;
+static constexpr size_t keys_per_thread = 3000;
+
+TEST_F(ConcurrentSkipListTest, LockFreeSingleThread) {
+	skip_list_space::concurrent_skip_list<size_t, size_t> list;
+	EXPECT_TRUE(list.empty());
+	EXPECT_FALSE(list.find(1).has_value());
+	EXPECT_FALSE(list.erase(1));
+	for (size_t index = 0; index < 1000; ++index)
+	{
+		EXPECT_TRUE(list.insert(std::pair<size_t, size_t>((index * 7) % 1000, index)));
+	}
+	EXPECT_FALSE(list.insert(std::pair<size_t, size_t>(7, 0)));
+	EXPECT_TRUE(list.size() == 1000);
+	EXPECT_TRUE(list.find(7).value() == 1);
+	for (size_t index = 0; index < 1000; index += 2)
+	{
+		EXPECT_TRUE(list.erase(index));
+	}
+	EXPECT_FALSE(list.erase(0));
+	EXPECT_TRUE(list.size() == 500);
+	size_t expected = 1;
+	list.for_each([&](const std::pair<const size_t, size_t>& value)
+		{
+			EXPECT_TRUE(value.first == expected);
+			expected += 2;
+		});
+	EXPECT_TRUE(expected == 1001);
+	EXPECT_TRUE(list.contains(999));
+	EXPECT_FALSE(list.contains(998));
+}
+
+TEST_F(ConcurrentSkipListTest, LockFreeInsertEraseFind) {
+	skip_list_space::concurrent_skip_list<size_t, size_t> list;
+	std::atomic<bool> writers_done{ false };
+	std::atomic<size_t> bad_reads{ 0 };
+	std::vector<std::thread> threads;
+	for (size_t thread = 0; thread < thread_count; ++thread)
+	{
+		threads.emplace_back([&list, thread]
+			{
+				for (size_t index = 0; index < keys_per_thread; ++index)
+				{
+					const size_t key = index * thread_count + thread;
+					list.insert(std::pair<size_t, size_t>(key, key * 2));
+				}
+				for (size_t index = 1; index < keys_per_thread; index += 2)
+				{
+					list.erase(index * thread_count + thread);
+				}
+			});
+	}
+	threads.emplace_back([&]
+		{
+			while (!writers_done.load())
+			{
+				for (size_t key = 0; key < keys_per_thread * thread_count; key += 13)
+				{
+					if (const auto value = list.find(key); value.has_value() && *value != key * 2)
+					{
+						++bad_reads;
+					}
+				}
+			}
+		});
+	for (size_t thread = 0; thread < thread_count; ++thread)
+	{
+		threads[thread].join();
+	}
+	writers_done = true;
+	threads.back().join();
+	EXPECT_TRUE(bad_reads == 0);
+	EXPECT_TRUE(list.size() == thread_count * keys_per_thread / 2);
+	size_t previous = 0;
+	size_t visited = 0;
+	list.for_each([&](const std::pair<const size_t, size_t>& value)
+		{
+			EXPECT_TRUE(visited == 0 || previous < value.first);
+			EXPECT_TRUE((value.first / thread_count) % 2 == 0);
+			previous = value.first;
+			++visited;
+		});
+	EXPECT_TRUE(visited == list.size());
+}
+
+TEST_F(ConcurrentSkipListTest, LockFreeContendedKeys) {
+	skip_list_space::concurrent_skip_list<size_t, size_t> list;
+	std::atomic<size_t> inserted{ 0 };
+	std::atomic<size_t> erased{ 0 };
+	std::vector<std::thread> threads;
+	for (size_t thread = 0; thread < thread_count; ++thread)
+	{
+		threads.emplace_back([&]
+			{
+				for (size_t round = 0; round < 2000; ++round)
+				{
+					const size_t key = round % 64;
+					if (list.insert(std::pair<size_t, size_t>(key, round)))
+					{
+						++inserted;
+					}
+					if (list.erase((round * 7) % 64))
+					{
+						++erased;
+					}
+				}
+			});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	EXPECT_TRUE(inserted - erased == list.size());
+	size_t visited = 0;
+	list.for_each([&](const std::pair<const size_t, size_t>&) { ++visited; });
+	EXPECT_TRUE(visited == list.size());
+}
+
+TEST_F(ConcurrentSkipListTest, LazySingleThread) {
+	skip_list_space::lazy_skip_list<size_t, size_t> list;
+	EXPECT_TRUE(list.begin() == list.end());
+	EXPECT_TRUE(list.find(1) == list.end());
+	EXPECT_TRUE(list.erase(1) == 0);
+	for (size_t index = 0; index < 1000; ++index)
+	{
+		auto [position, inserted] = list.insert(std::pair<size_t, size_t>((index * 7) % 1000, index));
+		EXPECT_TRUE(inserted);
+		EXPECT_TRUE(position->first == (index * 7) % 1000);
+	}
+	auto [existing, inserted] = list.insert(std::pair<size_t, size_t>(7, 0));
+	EXPECT_FALSE(inserted);
+	EXPECT_TRUE(existing->second == 1);
+	EXPECT_TRUE(list.size() == 1000);
+	(*list.find(7)).second = 70;
+	EXPECT_TRUE(list.find(7)->second == 70);
+	for (size_t index = 0; index < 1000; index += 2)
+	{
+		EXPECT_TRUE(list.erase(index) == 1);
+	}
+	EXPECT_TRUE(list.erase(0) == 0);
+	EXPECT_TRUE(list.size() == 500);
+	size_t expected = 1;
+	const auto& const_list = list;
+	for (const auto& [key, value] : const_list)
+	{
+		EXPECT_TRUE(key == expected);
+		expected += 2;
+	}
+	EXPECT_TRUE(expected == 1001);
+	EXPECT_TRUE(list.contains(999));
+	EXPECT_FALSE(list.contains(998));
+	EXPECT_TRUE(const_list.count(1) == 1);
+	static_assert(std::forward_iterator<skip_list_space::lazy_skip_list<size_t, size_t>::iterator>);
+	skip_list_space::lazy_skip_list<size_t, size_t>::const_iterator position;
+	position = list.find(999);
+	std::thread([position, &list]
+		{
+			auto copy = position;
+			EXPECT_TRUE(copy->first == 999 && ++copy == list.end());
+			list.erase(1);
+		}).join();
+	EXPECT_TRUE(position == list.find(999) && list.size() == 499);
+}
+
+TEST_F(ConcurrentSkipListTest, LazyInsertEraseScan) {
+	skip_list_space::lazy_skip_list<size_t, size_t> list;
+	std::atomic<bool> writers_done{ false };
+	std::atomic<size_t> bad_reads{ 0 };
+	std::vector<std::thread> threads;
+	for (size_t thread = 0; thread < thread_count; ++thread)
+	{
+		threads.emplace_back([&list, thread]
+			{
+				for (size_t index = 0; index < keys_per_thread; ++index)
+				{
+					const size_t key = index * thread_count + thread;
+					list.insert(std::pair<size_t, size_t>(key, key * 2));
+				}
+				for (size_t index = 1; index < keys_per_thread; index += 2)
+				{
+					list.erase(index * thread_count + thread);
+				}
+			});
+	}
+	threads.emplace_back([&]
+		{
+			while (!writers_done.load())
+			{
+				size_t previous = 0;
+				bool first = true;
+				for (const auto& [key, value] : list)
+				{
+					if (value != key * 2 || (!first && key <= previous))
+					{
+						++bad_reads;
+					}
+					previous = key;
+					first = false;
+				}
+				for (size_t key = 0; key < keys_per_thread * thread_count; key += 13)
+				{
+					if (auto found = list.find(key); found != list.end() && found->second != key * 2)
+					{
+						++bad_reads;
+					}
+				}
+			}
+		});
+	for (size_t thread = 0; thread < thread_count; ++thread)
+	{
+		threads[thread].join();
+	}
+	writers_done = true;
+	threads.back().join();
+	EXPECT_TRUE(bad_reads == 0);
+	EXPECT_TRUE(list.size() == thread_count * keys_per_thread / 2);
+	size_t visited = 0;
+	for (const auto& [key, value] : list)
+	{
+		EXPECT_TRUE((key / thread_count) % 2 == 0);
+		++visited;
+	}
+	EXPECT_TRUE(visited == list.size());
+}
+
+TEST_F(ConcurrentSkipListTest, LazyContendedKeys) {
+	skip_list_space::lazy_skip_list<size_t, size_t> list;
+	std::atomic<size_t> inserted{ 0 };
+	std::atomic<size_t> erased{ 0 };
+	std::vector<std::thread> threads;
+	for (size_t thread = 0; thread < thread_count; ++thread)
+	{
+		threads.emplace_back([&]
+			{
+				for (size_t round = 0; round < 2000; ++round)
+				{
+					if (list.insert(std::pair<size_t, size_t>(round % 64, round)).second)
+					{
+						++inserted;
+					}
+					erased += list.erase((round * 7) % 64);
+				}
+			});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	EXPECT_TRUE(inserted - erased == list.size());
+	size_t visited = 0;
+	for (auto position = list.begin(); position != list.end(); ++position)
+	{
+		++visited;
+	}
+	EXPECT_TRUE(visited == list.size());
+}
+
+TEST_F(ConcurrentSkipListTest, SingleWriterManyReaders) {
+	skip_list_space::single_writer_skip_list<size_t, size_t> list;
+	const auto& reader_view = list;
+	EXPECT_TRUE(reader_view.find(0) == reader_view.end());
+	std::atomic<bool> writer_done{ false };
+	std::atomic<size_t> bad_reads{ 0 };
+	std::vector<std::thread> readers;
+	for (size_t thread = 0; thread < thread_count; ++thread)
+	{
+		readers.emplace_back([&]
+			{
+				while (!writer_done.load())
+				{
+					auto guard = reader_view.read_lock();
+					size_t previous = 0;
+					bool first = true;
+					for (const auto& [key, value] : reader_view)
+					{
+						if (value != key * 2 || (!first && key <= previous))
+						{
+							++bad_reads;
+						}
+						previous = key;
+						first = false;
+					}
+					for (size_t key = 0; key < keys_per_thread; key += 7)
+					{
+						if (auto found = reader_view.find(key); found != reader_view.cend() && (*found).second != key * 2)
+						{
+							++bad_reads;
+						}
+						if (auto lower = reader_view.lower_bound(key); lower != reader_view.cend() && (*lower).first < key)
+						{
+							++bad_reads;
+						}
+						if (auto found = list.find(key + 1); found != list.end() && (*found).second != (key + 1) * 2)
+						{
+							++bad_reads;
+						}
+					}
+				}
+			});
+	}
+	for (size_t round = 0; round < 4; ++round)
+	{
+		for (size_t key = 0; key < keys_per_thread; ++key)
+		{
+			list.insert(std::pair<size_t, size_t>(key, key * 2));
+		}
+		for (size_t key = round % 2; key < keys_per_thread; key += 2)
+		{
+			list.erase(key);
+		}
+		list.erase(list.lower_bound(100), list.lower_bound(200));
+		if (round == 2)
+		{
+			list.clear();
+		}
+	}
+	writer_done = true;
+	for (auto& reader : readers)
+	{
+		reader.join();
+	}
+	EXPECT_TRUE(bad_reads == 0);
+	list.reclaim_retired();
+	size_t visited = 0;
+	for (const auto& [key, value] : list)
+	{
+		EXPECT_TRUE(key % 2 == 0 && (key < 100 || key >= 200));
+		++visited;
+	}
+	EXPECT_TRUE(visited == list.size());
+	EXPECT_TRUE(list.at(0) == 0);
+	auto moved = std::move(list);
+	EXPECT_TRUE(moved.at(0) == 0);
+	{
+		auto guard = reader_view.read_lock();
+		EXPECT_TRUE(reader_view.find(0) == reader_view.end());
+	}
+	list.reclaim_retired();
+	list.insert(std::pair<size_t, size_t>(1, 2));
+	list.erase(1);
+	list.reclaim_retired();
+	EXPECT_TRUE(list.empty());
+}
+
+TEST_F(ConcurrentSkipListTest, VersionedSnapshots) {
+	skip_list_space::versioned_skip_list<size_t, size_t> list;
+	auto empty_view = list.snapshot();
+	for (size_t key = 0; key < 100; ++key)
+	{
+		EXPECT_TRUE(list.insert_or_assign(key, key));
+	}
+	std::optional<decltype(list.snapshot())> first_view;
+	first_view.emplace(list.snapshot());
+	for (size_t key = 0; key < 100; key += 2)
+	{
+		EXPECT_FALSE(list.insert_or_assign(key, key + 1000));
+	}
+	for (size_t key = 1; key < 100; key += 2)
+	{
+		EXPECT_TRUE(list.erase(key));
+	}
+	EXPECT_FALSE(list.erase(1));
+	EXPECT_TRUE(list.size() == 50);
+	EXPECT_TRUE(list.find(2).value() == 1002);
+	EXPECT_FALSE(list.contains(3));
+	EXPECT_TRUE(empty_view.begin() == empty_view.end());
+	EXPECT_FALSE(empty_view.contains(0));
+	size_t expected = 0;
+	for (const auto& [key, value] : *first_view)
+	{
+		EXPECT_TRUE(key == expected && value == expected);
+		++expected;
+	}
+	EXPECT_TRUE(expected == 100);
+	EXPECT_TRUE(first_view->find(3).value() == 3);
+	EXPECT_TRUE((*first_view->lower_bound(50)).first == 50);
+	{
+		auto second_view = list.snapshot();
+		EXPECT_TRUE((*second_view.lower_bound(49)).first == 50);
+		EXPECT_TRUE((*second_view.begin()).second == 1000);
+	}
+	list.collect_garbage();
+	EXPECT_TRUE(first_view->find(98).value() == 98);
+	EXPECT_TRUE(list.insert_or_assign(1, 1));
+	first_view.reset();
+	list.collect_garbage();
+	auto last_view = list.snapshot();
+	expected = 0;
+	for (const auto& [key, value] : last_view)
+	{
+		EXPECT_TRUE(key == 1 || (key % 2 == 0 && value == key + 1000));
+		++expected;
+	}
+	EXPECT_TRUE(expected == list.size());
+}
+
+TEST_F(ConcurrentSkipListTest, VersionedSnapshotsUnderWrites) {
+	skip_list_space::versioned_skip_list<size_t, size_t> list;
+	static constexpr size_t key_count = 500;
+	for (size_t key = 0; key < key_count; ++key)
+	{
+		list.insert_or_assign(key, 0);
+	}
+	std::atomic<bool> writer_done{ false };
+	std::atomic<size_t> bad_reads{ 0 };
+	std::vector<std::thread> readers;
+	for (size_t thread = 0; thread < thread_count; ++thread)
+	{
+		readers.emplace_back([&]
+			{
+				while (!writer_done.load())
+				{
+					auto view = list.snapshot();
+					size_t previous = 0;
+					size_t visited = 0;
+					for (const auto& [key, value] : view)
+					{
+						if (key >= key_count)
+						{
+							continue;
+						}
+						if ((visited != 0 && (value > previous || previous - value > 1)) || key != visited)
+						{
+							++bad_reads;
+						}
+						previous = value;
+						++visited;
+					}
+					if (visited != key_count)
+					{
+						++bad_reads;
+					}
+				}
+			});
+	}
+	for (size_t round = 1; round <= 50; ++round)
+	{
+		for (size_t key = 0; key < key_count; ++key)
+		{
+			list.insert_or_assign(key, round);
+		}
+		list.erase(key_count + round - 1);
+		list.insert_or_assign(key_count + round, round);
+		list.erase(key_count + round);
+	}
+	writer_done = true;
+	for (auto& reader : readers)
+	{
+		reader.join();
+	}
+	EXPECT_TRUE(bad_reads == 0);
+	EXPECT_TRUE(list.size() == key_count);
+	list.collect_garbage();
+	EXPECT_TRUE(list.snapshot().find(key_count - 1).value() == 50);
+}
+
+TEST_F(ConcurrentSkipListTest, VersionedLatestReadsUnderWrites) {
+	skip_list_space::versioned_skip_list<size_t, std::string> list;
+	list.insert_or_assign(0, std::string(64, 'a'));
+	std::atomic<bool> writer_done{ false };
+	std::atomic<size_t> bad_reads{ 0 };
+	std::vector<std::thread> readers;
+	for (size_t thread = 0; thread < thread_count; ++thread)
+	{
+		readers.emplace_back([&]
+			{
+				while (!writer_done.load())
+				{
+					const auto value = list.find(0);
+					if (!value.has_value() || value->size() != 64 || value->find_first_not_of(value->front()) != std::string::npos || !list.contains(0))
+					{
+						++bad_reads;
+					}
+				}
+			});
+	}
+	for (size_t round = 0; round < 20000; ++round)
+	{
+		list.insert_or_assign(0, std::string(64, static_cast<char>('a' + round % 26)));
+	}
+	writer_done = true;
+	for (auto& reader : readers)
+	{
+		reader.join();
+	}
+	EXPECT_TRUE(bad_reads == 0);
+	list.collect_garbage();
+	EXPECT_TRUE(list.find(0).value() == std::string(64, static_cast<char>('a' + 19999 % 26)));
+}
+
+TEST_F(ConcurrentSkipListTest, ShardedSingleThread) {
+	skip_list_space::sharded_skip_list<size_t, size_t> list(std::vector<size_t>{ 500, 100, 500 }, 64);
+	EXPECT_TRUE(list.shard_count() == 3);
+	EXPECT_TRUE(list.empty());
+	for (size_t index = 0; index < 1000; ++index)
+	{
+		EXPECT_TRUE(list.insert(std::pair<size_t, size_t>((index * 7) % 1000, index)));
+	}
+	EXPECT_FALSE(list.insert(std::pair<size_t, size_t>(7, 0)));
+	EXPECT_FALSE(list.insert_or_assign(7, 70));
+	EXPECT_TRUE(list.insert_or_assign(1000, 1));
+	EXPECT_TRUE(list.size() == 1001);
+	EXPECT_TRUE(list.find(7).value() == 70);
+	EXPECT_TRUE(list.shard_count() > 3);
+	const auto split_keys = list.get_split_keys();
+	EXPECT_TRUE(std::is_sorted(split_keys.begin(), split_keys.end()));
+	for (size_t key = 0; key < 1000; key += 2)
+	{
+		EXPECT_TRUE(list.erase(key));
+	}
+	EXPECT_FALSE(list.erase(0));
+	EXPECT_FALSE(list.contains(0));
+	EXPECT_TRUE(list.contains(1));
+	size_t expected = 1;
+	list.for_each([&](const size_t& key, const size_t&)
+		{
+			EXPECT_TRUE(key == expected);
+			expected += key < 999 ? 2 : 1;
+		});
+	EXPECT_TRUE(expected == 1001);
+	std::vector<size_t> range;
+	list.for_each_in_range(95, 505, [&](const size_t& key, const size_t&) { range.push_back(key); });
+	EXPECT_TRUE(range.size() == 205 && range.front() == 95 && range.back() == 503);
+	list.clear();
+	EXPECT_TRUE(list.empty());
+	EXPECT_FALSE(list.find(1).has_value());
+}
+
+TEST_F(ConcurrentSkipListTest, ShardedConcurrentWrites) {
+	skip_list_space::sharded_skip_list<size_t, size_t> list(256);
+	std::vector<std::thread> threads;
+	for (size_t thread = 0; thread < thread_count; ++thread)
+	{
+		threads.emplace_back([&list, thread]
+			{
+				for (size_t index = 0; index < keys_per_thread; ++index)
+				{
+					const size_t key = index * thread_count + thread;
+					list.insert(std::pair<size_t, size_t>(key, key));
+					if (index % 3 == 0)
+					{
+						list.erase(key);
+					}
+					else if (!list.contains(key))
+					{
+						list.insert_or_assign(key, 0);
+					}
+				}
+			});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+	EXPECT_TRUE(list.shard_count() > 1);
+	size_t visited = 0;
+	size_t previous = 0;
+	list.for_each([&](const size_t& key, const size_t& value)
+		{
+			EXPECT_TRUE((visited == 0 || key > previous) && key == value && (key / thread_count) % 3 != 0);
+			previous = key;
+			++visited;
+		});
+	EXPECT_TRUE(visited == list.size());
+	EXPECT_TRUE(visited == thread_count * (keys_per_thread - (keys_per_thread + 2) / 3));
+}
@@ -47,4 +47,73 @@ TEST(LevelTest, CompareOperation)
 	EXPECT_TRUE(level_first < second_start_value);
 	EXPECT_TRUE(level_first >= start_value);
 	
-}
\ No newline at end of file
+}
+
+template<typename Generator>
+void check_level_distribution(const double probability)
+{
+	constexpr size_t max_level = 32;
+	constexpr size_t count = 100000;
+	Generator generator;
+	size_t promoted = 0;
+	for (size_t index = 0; index < count; ++index)
+	{
+		const auto level = generator(max_level);
+		EXPECT_TRUE(level >= 1 && level <= max_level);
+		promoted += level > 1 ? 1 : 0;
+	}
+	EXPECT_NEAR(static_cast<double>(promoted) / count, probability, 0.01);
+}
+
+TEST(LevelTest, GeneratorDistribution)
+{
+	check_level_distribution<random_tools::level_generator<>>(0.5);
+	check_level_distribution<random_tools::level_generator<random_tools::xorshift64, random_tools::promotion_quarter>>(0.25);
+	check_level_distribution<random_tools::level_generator<std::mt19937, random_tools::promotion_inverse_e>>(0.367879441171);
+	check_level_distribution<random_tools::level_generator<std::mt19937_64, random_tools::promotion_quarter, 9438U>>(0.25);
+}
+
+TEST(LevelTest, GeneratorMaxLevel)
+{
+	random_tools::level_generator<> generator;
+	for (size_t index = 0; index < 1000; ++index)
+	{
+		EXPECT_TRUE(generator(1) == 1);
+		EXPECT_TRUE(generator(3) <= 3);
+	}
+	random_tools::level_generator<> first(42);
+	random_tools::level_generator<> second(42);
+	for (size_t index = 0; index < 1000; ++index)
+	{
+		EXPECT_TRUE(first(64) == second(64));
+	}
+}
+
+template <size_t Returned_level>
+struct fixed_level_generator
+{
+	size_t operator()(const size_t) const noexcept { return Returned_level; }
+};
+
+template <size_t Returned_level>
+void check_out_of_range_generator()
+{
+	skip_list_space::skip_list<size_t, size_t, std::less<size_t>, 16, std::allocator<std::pair<const size_t, size_t>>, fixed_level_generator<Returned_level>> list;
+	for (size_t index = 0; index < 200; ++index)
+	{
+		list.insert(std::pair<size_t, size_t>(index * 2, index));
+	}
+	auto copy = list;
+	copy.assign({ { 1, 1 }, { 3, 3 }, { 5, 5 } });
+	for (size_t index = 0; index < 200; index += 3)
+	{
+		list.erase(index * 2);
+	}
+	EXPECT_TRUE(list.size() == 133 && (*list.find(2)).second == 1 && copy.size() == 3);
+}
+
+TEST(LevelTest, GeneratorOutOfRange)
+{
+	check_out_of_range_generator<0>();
+	check_out_of_range_generator<1000>();
+}
@@ -18,53 +18,111 @@ protected:
 TEST_F(SkipListNodeTest, Constructor) {
 	constexpr size_t max_size = 16;
 	using Node = skip_list_space::node<int, int, max_size>;
-	Node default_node;
-	EXPECT_THROW(default_node.next(), std::out_of_range);
-	EXPECT_THROW(default_node.prev(), std::out_of_range);
-	EXPECT_THROW(auto test_value = Node(std::pair(1, 2), max_size + 1), std::out_of_range);
-	auto first_node = Node(std::pair(1, 2), max_size - 1);
-	auto second_node(first_node);
-	EXPECT_TRUE(first_node.get_key() == second_node.get_key());
-	EXPECT_TRUE(first_node.get_level() == second_node.get_level());
-	EXPECT_TRUE(first_node.get_value() == second_node.get_value());
-	auto move_node(std::move(first_node));
-	EXPECT_FALSE(first_node.is_valid());
+	skip_list_space::node_pool<Node, std::allocator<std::pair<const int, int>>, max_size> pool;
+	auto sentinel = Node::create_sentinel(pool, 0);
+	EXPECT_THROW(sentinel->next(), std::out_of_range);
+	EXPECT_TRUE(sentinel->prev() == nullptr);
+	EXPECT_FALSE(sentinel->is_valid());
+	EXPECT_THROW(Node::create(pool, std::pair(1, 2), max_size + 1), std::out_of_range);
+	auto first_node = Node::create(pool, std::pair(1, 2), max_size - 1);
+	auto second_node = Node::create(pool, first_node->get_node_value(), first_node->get_level());
+	EXPECT_TRUE(first_node->get_key() == second_node->get_key());
+	EXPECT_TRUE(first_node->get_level() == second_node->get_level());
+	EXPECT_TRUE(first_node->get_value() == second_node->get_value());
+	EXPECT_TRUE(first_node->is_valid());
+	Node::destroy(pool, first_node);
+	Node::destroy(pool, second_node);
+	Node::destroy(pool, sentinel);
 }
 
 TEST_F(SkipListNodeTest, NodeOutOfRange) {
 	constexpr size_t max_size = 16;
 	using Node = skip_list_space::node<user_class<int>, int, max_size>;
-	Node default_node;
-	EXPECT_THROW(default_node.next(), std::out_of_range);
-	EXPECT_THROW(default_node.prev(), std::out_of_range);
-	EXPECT_THROW(auto test_value = Node(std::pair(user_class(1), 2), max_size + 1), std::out_of_range);
-	auto first_node = Node(std::pair(user_class(1), 2), max_size - 1);
-	auto second_node(first_node);
-	EXPECT_TRUE(first_node.get_key() == second_node.get_key());
-	EXPECT_TRUE(first_node.get_level() == second_node.get_level());
-	EXPECT_TRUE(first_node.get_value() == second_node.get_value());
-	auto move_node(std::move(first_node));
-	EXPECT_FALSE(first_node.is_valid());
+	skip_list_space::node_pool<Node, std::allocator<std::pair<const user_class<int>, int>>, max_size> pool;
+	auto sentinel = Node::create_sentinel(pool, 0);
+	EXPECT_THROW(sentinel->next(), std::out_of_range);
+	EXPECT_THROW(sentinel->set_right_node(0, nullptr), std::out_of_range);
+	EXPECT_THROW(Node::create(pool, std::pair(user_class(1), 2), max_size + 1), std::out_of_range);
+	auto first_node = Node::create(pool, std::pair(user_class(1), 2), max_size - 1);
+	auto second_node = Node::create(pool, first_node->get_node_value(), first_node->get_level());
+	EXPECT_TRUE(first_node->get_key() == second_node->get_key());
+	EXPECT_TRUE(first_node->get_level() == second_node->get_level());
+	EXPECT_TRUE(first_node->get_value() == second_node->get_value());
+	EXPECT_THROW(first_node->set_right_node(max_size - 1, second_node), std::out_of_range);
+	Node::destroy(pool, first_node);
+	Node::destroy(pool, second_node);
+	Node::destroy(pool, sentinel);
 }
 
 TEST_F(SkipListNodeTest, NodeOperationSetGet) {
 	constexpr size_t max_size = 16;
 	using Node = skip_list_space::node<int, int, max_size>;
-	auto first_node = Node(std::pair(1, 2), max_size - 1);
-	auto second_node = Node(std::pair(2, 3), max_size - 1);
-	auto third_node = Node(std::pair(3, 4), max_size - 1);
+	skip_list_space::node_pool<Node, std::allocator<std::pair<const int, int>>, max_size> pool;
+	auto first_node = Node::create(pool, std::pair(1, 2), max_size);
+	auto second_node = Node::create(pool, std::pair(2, 3), max_size);
+	auto third_node = Node::create(pool, std::pair(3, 4), max_size);
 	static_assert(std::is_convertible_v<const std::pair<double,double >, std::pair<double, double >>);
-	skip_list_space::node<int, int, max_size>::bind_node(&first_node, &second_node, max_size);
-	EXPECT_TRUE(*first_node.next() == second_node);
-	EXPECT_TRUE( *second_node.prev() == first_node);
+	Node::bind_node(first_node, second_node);
+	EXPECT_TRUE(*first_node->next() == *second_node);
+	EXPECT_TRUE(*second_node->prev() == *first_node);
 	for(size_t index = 0; index < max_size; ++index)
 	{
-		EXPECT_TRUE(*second_node.get_left_node(index) == first_node);
-		EXPECT_TRUE(*first_node.get_right_node(index) == second_node);
+		EXPECT_TRUE(*first_node->get_right_node(index) == *second_node);
 	}
 	for (size_t index = 0; index < max_size ; ++index)
 	{
-		second_node.set_right_node(index, &third_node);
-		EXPECT_TRUE(*second_node.get_right_node(index) == third_node);
+		second_node->set_right_node(index, third_node);
+		EXPECT_TRUE(*second_node->get_right_node(index) == *third_node);
 	}
+	Node::destroy(pool, first_node);
+	Node::destroy(pool, second_node);
+	Node::destroy(pool, third_node);
+}
+
+TEST_F(SkipListNodeTest, NodeLink) {
+	constexpr size_t max_size = 4;
+	using Node = skip_list_space::node<int, int, max_size>;
+	skip_list_space::node_pool<Node, std::allocator<std::pair<const int, int>>, max_size> pool;
+	auto head = Node::create_sentinel(pool, max_size);
+	auto tail = Node::create_sentinel(pool, 0);
+	Node::bind_node(head, tail);
+	auto middle_node = Node::create(pool, std::pair(1, 1), 2);
+	EXPECT_TRUE(Node::allocation_size(2) < Node::allocation_size(max_size));
+	for (size_t index = 0; index < middle_node->get_level(); ++index)
+	{
+		middle_node->link_with_left_node(head, index);
+	}
+	EXPECT_TRUE(head->next() == middle_node);
+	EXPECT_TRUE(head->get_right_node(2) == tail);
+	EXPECT_TRUE(tail->prev() == middle_node);
+	EXPECT_TRUE(middle_node->next() == tail);
+	for (size_t index = 0; index < middle_node->get_level(); ++index)
+	{
+		middle_node->unlink_from_left_node(head, index);
+	}
+	EXPECT_TRUE(head->next() == tail);
+	EXPECT_TRUE(tail->prev() == head);
+	Node::destroy(pool, middle_node);
+	Node::destroy(pool, head);
+	Node::destroy(pool, tail);
+}
+
+
+TEST_F(SkipListNodeTest, PoolRecycling) {
+	constexpr size_t max_size = 8;
+	using Node = skip_list_space::node<int, int, max_size>;
+	skip_list_space::node_pool<Node, std::allocator<std::pair<const int, int>>, max_size> pool;
+	auto first_node = Node::create(pool, std::pair(1, 2), 3);
+	auto first_address = static_cast<void*>(first_node);
+	Node::destroy(pool, first_node);
+	auto other_level_node = Node::create(pool, std::pair(2, 3), 4);
+	EXPECT_TRUE(static_cast<void*>(other_level_node) != first_address);
+	auto same_level_node = Node::create(pool, std::pair(3, 4), 3);
+	EXPECT_TRUE(static_cast<void*>(same_level_node) == first_address);
+	EXPECT_TRUE(same_level_node->get_key() == 3);
+	Node::destroy(pool, other_level_node);
+	Node::destroy(pool, same_level_node);
+	pool.release();
+	auto new_node = Node::create(pool, std::pair(4, 5), 3);
+	Node::destroy(pool, new_node);
 }
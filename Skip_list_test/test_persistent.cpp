@@ -0,0 +1,84 @@
+#include "pch.h"
+#include <cstdio>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <filesystem>
+#include "persistent_skip_list.h"
+
+class PersistentSkipListTest : public ::testing::Test {
+protected:
+	virtual void SetUp(void) {
+		path = (std::filesystem::temp_directory_path() / ("skip_list_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()) + ".bin")).string();
+		std::filesystem::remove(path);
+	}
+	virtual void TearDown(void) {
+		std::filesystem::remove(path);
+	}
+	std::string path;
+};
+
+TEST_F(PersistentSkipListTest, ReopenKeepsContent) {
+	{
+		skip_list_space::persistent_skip_list<uint64_t, double> list(path, 4096);
+		EXPECT_TRUE(list.empty());
+		EXPECT_TRUE(list.find(1) == list.end());
+		for (uint64_t index = 0; index < 5000; ++index)
+		{
+			EXPECT_TRUE(list.insert((index * 7) % 5000, static_cast<double>(index)));
+		}
+		EXPECT_FALSE(list.insert(7, 0.0));
+		EXPECT_FALSE(list.insert_or_assign(7, 0.5));
+		EXPECT_TRUE(list.capacity() > 4096);
+		for (uint64_t key = 0; key < 5000; key += 2)
+		{
+			EXPECT_TRUE(list.erase(key));
+		}
+		EXPECT_FALSE(list.erase(0));
+		EXPECT_TRUE(list.insert(10000, 1.0));
+		list.flush();
+	}
+	skip_list_space::persistent_skip_list<uint64_t, double> list(path);
+	EXPECT_TRUE(list.size() == 2501);
+	EXPECT_TRUE((*list.find(7)).second == 0.5);
+	EXPECT_TRUE((*list.lower_bound(4)).first == 5);
+	EXPECT_FALSE(list.contains(4));
+	uint64_t expected = 1;
+	for (const auto& [key, value] : list)
+	{
+		EXPECT_TRUE(key == expected);
+		expected += key < 4999 ? 2 : 5001;
+	}
+	EXPECT_TRUE(expected == 15001);
+	const auto capacity = list.capacity();
+	for (uint64_t key = 0; key < 5000; key += 2)
+	{
+		EXPECT_TRUE(list.insert(key, 2.0));
+	}
+	EXPECT_TRUE(list.capacity() == capacity);
+	list.clear();
+	EXPECT_TRUE(list.empty() && list.begin() == list.end());
+}
+
+TEST_F(PersistentSkipListTest, RejectsIncompatibleFile) {
+	{
+		skip_list_space::persistent_skip_list<uint64_t, uint64_t> list(path);
+		EXPECT_TRUE(list.insert(1, 1));
+	}
+	EXPECT_THROW((skip_list_space::persistent_skip_list<uint64_t, uint32_t>(path)), std::runtime_error);
+	EXPECT_THROW((skip_list_space::persistent_skip_list<uint64_t, uint64_t, std::less<uint64_t>, 16>(path)), std::runtime_error);
+	std::FILE* truncated = std::fopen(path.c_str(), "wb");
+	std::fputs("skip", truncated);
+	std::fclose(truncated);
+	EXPECT_THROW((skip_list_space::persistent_skip_list<uint64_t, uint64_t>(path)), std::runtime_error);
+}
+
+TEST_F(PersistentSkipListTest, FailedResizeKeepsMapping) {
+	skip_list_space::mapped_file file(path, 4096);
+	file.data()[100] = std::byte{ 42 };
+	EXPECT_THROW(file.resize(std::numeric_limits<size_t>::max()), std::system_error);
+	EXPECT_TRUE(file.data() != nullptr && file.size() == 4096 && file.data()[100] == std::byte{ 42 });
+	file.resize(8192);
+	EXPECT_TRUE(file.size() == 8192 && file.data()[100] == std::byte{ 42 });
+}
@@ -0,0 +1,124 @@
+#include "pch.h"
+#include <map>
+#include <string>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include "unrolled_skip_list.h"
+
+TEST(UnrolledSkipListTest, MatchesMap) {
+	skip_list_space::unrolled_skip_list<int, int, std::less<int>, 16, 4> list;
+	std::map<int, int> expected;
+	random_tools::splitmix64 engine(7);
+	for (int step = 0; step < 40000; ++step)
+	{
+		const int key = static_cast<int>(engine() % 2000);
+		switch (engine() % 4)
+		{
+		case 0:
+		case 1:
+			EXPECT_TRUE(list.insert(std::pair<int, int>(key, step)).second == expected.emplace(key, step).second);
+			break;
+		case 2:
+			EXPECT_TRUE(list.erase(key) == (expected.erase(key) == 1));
+			break;
+		default:
+			EXPECT_TRUE(list.contains(key) == expected.contains(key));
+			break;
+		}
+		if (step % 5000 == 0)
+		{
+			EXPECT_TRUE(std::equal(list.begin(), list.end(), expected.begin(), expected.end(),
+				[](const auto& entry, const auto& expected_entry) { return entry.first == expected_entry.first && entry.second == expected_entry.second; }));
+		}
+	}
+	EXPECT_TRUE(list.size() == expected.size());
+	EXPECT_TRUE(list.node_count() * 4 >= list.size() && list.node_count() <= list.size());
+	for (const auto& [key, value] : expected)
+	{
+		EXPECT_TRUE(list.at(key) == value);
+	}
+	auto position = list.lower_bound(1000);
+	EXPECT_TRUE((*position).first == expected.lower_bound(1000)->first);
+	EXPECT_TRUE(list.lower_bound(5000) == list.end());
+	for (int key = 0; key < 2000; ++key)
+	{
+		list.erase(key);
+	}
+	EXPECT_TRUE(list.empty() && list.node_count() == 0 && list.begin() == list.end());
+	EXPECT_TRUE(list.insert(std::pair<int, int>(1, 1)).second);
+}
+
+TEST(UnrolledSkipListTest, StringsCopyAndMove) {
+	using list_type = skip_list_space::unrolled_skip_list<std::string, std::string>;
+	list_type list;
+	EXPECT_THROW(list.at("missing"), std::out_of_range);
+	EXPECT_THROW(*list.begin(), error_dereferencing_end);
+	for (int index = 0; index < 1000; ++index)
+	{
+		list.insert(std::pair<std::string, std::string>(std::to_string(100000 + index), std::to_string(index)));
+	}
+	EXPECT_TRUE(list.node_count() == (1000 + list_type::node_capacity - 1) / list_type::node_capacity);
+	list["050000"] = "front";
+	EXPECT_FALSE(list.insert_or_assign("100005", std::string("five")).second);
+	EXPECT_TRUE(list.insert_or_assign("200000", std::string("last")).second);
+	list_type copy(list);
+	EXPECT_TRUE(copy.size() == 1002 && (*copy.begin()).second == "front");
+	EXPECT_TRUE(copy.find("100005") != copy.end() && (*copy.find("100005")).second == "five");
+	list_type moved(std::move(copy));
+	EXPECT_TRUE(copy.empty() && moved.size() == 1002);
+	copy = moved;
+	moved.clear();
+	EXPECT_TRUE(moved.empty() && moved.find("100005") == moved.end());
+	moved = std::move(copy);
+	list_type::const_iterator position = moved.find("200000");
+	EXPECT_TRUE((*position).second == "last" && ++position == moved.end());
+	EXPECT_TRUE(std::equal(moved.begin(), moved.end(), list.begin(), list.end(),
+		[](const auto& entry, const auto& other_entry) { return entry.first == other_entry.first && entry.second == other_entry.second; }));
+}
+
+template<typename Key>
+void expect_simd_count_matches_lower_bound(random_tools::splitmix64& engine)
+{
+	for (size_t count = 0; count <= 70; ++count)
+	{
+		std::vector<Key> keys{ std::numeric_limits<Key>::lowest(), std::numeric_limits<Key>::max(), Key{ 0 } };
+		while (keys.size() < count)
+		{
+			const auto bits = engine();
+			keys.push_back(std::is_floating_point_v<Key> ? static_cast<Key>(static_cast<int64_t>(bits) % 100000) / Key{ 8 } : static_cast<Key>(bits));
+		}
+		keys.resize(count);
+		std::sort(keys.begin(), keys.end());
+		std::vector<Key> probes(keys.begin(), keys.end());
+		probes.insert(probes.end(), { std::numeric_limits<Key>::lowest(), std::numeric_limits<Key>::max(), Key{ 0 }, static_cast<Key>(engine()) });
+		for (const auto probe : probes)
+		{
+			const auto expected = static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(), probe) - keys.begin());
+			EXPECT_EQ(skip_list_space::count_less_keys(keys.data(), keys.size(), probe), expected);
+		}
+	}
+}
+
+TEST(UnrolledSkipListTest, SimdKeySearch) {
+	random_tools::splitmix64 engine(11);
+	expect_simd_count_matches_lower_bound<int32_t>(engine);
+	expect_simd_count_matches_lower_bound<uint32_t>(engine);
+	expect_simd_count_matches_lower_bound<int64_t>(engine);
+	expect_simd_count_matches_lower_bound<uint64_t>(engine);
+	expect_simd_count_matches_lower_bound<float>(engine);
+	expect_simd_count_matches_lower_bound<double>(engine);
+	skip_list_space::unrolled_skip_list<uint64_t, uint64_t> timestamps;
+	std::map<uint64_t, uint64_t> expected;
+	for (uint64_t index = 0; index < 20000; ++index)
+	{
+		const uint64_t key = engine() | (index % 2 == 0 ? uint64_t{ 1 } << 63 : 0);
+		timestamps.insert(std::pair<uint64_t, uint64_t>(key, index));
+		expected.emplace(key, index);
+	}
+	for (const auto& [key, value] : expected)
+	{
+		EXPECT_TRUE(timestamps.at(key) == value);
+		EXPECT_FALSE(timestamps.contains(key + 1) != expected.contains(key + 1));
+	}
+}
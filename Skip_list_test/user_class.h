@@ -124,4 +124,36 @@ class bad_value final
 public:
 	bad_value(const bad_value& other) = delete;
 	bool operator==(const bad_value&) const= delete;
-};
\ No newline at end of file
+};
+
+struct allocation_counter
+{
+	inline static size_t allocated = 0;
+	inline static size_t deallocated = 0;
+};
+
+template<typename Value>
+class counting_allocator : public allocation_counter
+{
+public:
+	using value_type = Value;
+
+	counting_allocator() = default;
+	template<typename Other>
+	counting_allocator(const counting_allocator<Other>&) noexcept {}
+
+	Value* allocate(size_t count)
+	{
+		allocated += count * sizeof(Value);
+		return std::allocator<Value>().allocate(count);
+	}
+
+	void deallocate(Value* pointer, size_t count) noexcept
+	{
+		deallocated += count * sizeof(Value);
+		std::allocator<Value>().deallocate(pointer, count);
+	}
+
+	template<typename Other>
+	bool operator==(const counting_allocator<Other>&) const noexcept { return true; }
+};